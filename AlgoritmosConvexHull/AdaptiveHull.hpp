@@ -0,0 +1,342 @@
+/*Envolvente convexa que escoge el algoritmo segun una muestra de la entrada*/
+#ifndef ADAPTIVE_HULL
+#define ADAPTIVE_HULL
+#include "ConvexHulls.hpp"
+#include "IntHull.hpp"
+#include <vector>
+#include <thread>
+#include <functional>
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+// Todas las envolventes de este archivo regresan los vertices en sentido antihorario
+// empezando por el menor punto y sin puntos colineales, igual que monotoneChain.
+
+// r esta estrictamente a la derecha de q->a
+inline bool rightOf(Point q, Point a, Point r){
+    return cross(a - q, r - q) < -EPS;
+}
+
+// QuickHull: cada llamada recibe en p[lo, hi) los puntos a la derecha de a->b, toma el mas
+// lejano c y solo sigue con los que quedan fuera del triangulo abc. Todo se hace en su lugar.
+void quickHullRec(vector<Point> &p, int lo, int hi, Point a, Point b, vector<Point> &CH){
+    if(lo >= hi) return;
+    // Entre los igual de lejanos se toma el mas cercano a a, asi c siempre es vertice
+    int far = lo;
+    for(int i = lo + 1; i < hi; i++){
+        double d = cross(b - a, p[i] - a), dFar = cross(b - a, p[far] - a);
+        if(d < dFar - EPS || (d <= dFar + EPS && dot(p[i] - a, b - a) < dot(p[far] - a, b - a))) far = i;
+    }
+    Point c = p[far];
+    int m1 = partition(p.begin() + lo, p.begin() + hi, [&](const Point &q){ return rightOf(a, c, q); }) - p.begin();
+    int m2 = partition(p.begin() + m1, p.begin() + hi, [&](const Point &q){ return rightOf(c, b, q); }) - p.begin();
+    quickHullRec(p, lo, m1, a, c, CH);
+    CH.push_back(c);
+    quickHullRec(p, m1, m2, c, b, CH);
+}
+
+vector<Point> quickHull(vector<Point> &p){
+    int n = sz(p);
+    if(n == 0) return p;
+    int lo = 0, hi = 0;
+    for(int i = 1; i < n; i++){
+        if(p[i] < p[lo]) lo = i;
+        if(p[hi] < p[i]) hi = i;
+    }
+    Point a = p[lo], b = p[hi];
+    if(a == b) return {a};
+
+    vector<Point> CH;
+    int m1 = partition(p.begin(), p.end(), [&](const Point &q){ return rightOf(a, b, q); }) - p.begin();
+    int m2 = partition(p.begin() + m1, p.end(), [&](const Point &q){ return rightOf(b, a, q); }) - p.begin();
+    CH.push_back(a);
+    quickHullRec(p, 0, m1, a, b, CH);
+    CH.push_back(b);
+    quickHullRec(p, m1, m2, b, a, CH);
+    return CH;
+}
+
+// Vertice de la envolvente h (antihoraria, estrictamente convexa, al menos 3 vertices) que deja
+// a todo h a la izquierda visto desde q, en O(log k). Si q esta sobre el borde de h regresa
+// el vertice que le sigue.
+int hullTangent(const vector<Point> &h, int off, int k, Point q){
+    auto H = [&](int i){ return h[off + (i % k + k) % k]; };
+    auto up = [&](int i){ return rightOf(q, H(i), H(i+1)); };
+    auto isTangent = [&](int i){ return !up(i) && !rightOf(q, H(i), H(i-1)); };
+    int r;
+
+    if(!rightOf(H(0), H(1), q) && !rightOf(H(k-1), H(0), q)){
+        // q dentro del abanico desde H(0): se busca su sector
+        int lo = 1, hi = k - 2;
+        while(lo < hi){
+            int c = (lo + hi + 1) / 2;
+            if(rightOf(H(0), H(c), q)) hi = c - 1;
+            else lo = c;
+        }
+        if(!rightOf(H(lo), H(lo+1), q)){
+            // Dentro o sobre el borde; como q es vertice de la envolvente total esta en el borde
+            if(q == H(0)) r = 1;
+            else if(!ccw(H(k-1), H(0), q)) r = 0;
+            else if(!ccw(H(0), H(1), q)) r = 1;
+            else r = lo + 1;
+            if(H(r) == q) r++;
+            return (r % k + k) % k;
+        }
+    }
+
+    // q afuera: binaria sobre la secuencia ciclica de angulos vistos desde q
+    if(isTangent(0)) r = 0;
+    else{
+        bool up0 = up(0);
+        int lo = 1, hi = k - 1;
+        while(lo < hi){
+            int c = (lo + hi) / 2;
+            if(isTangent(c)){ lo = hi = c; break; }
+            bool upc = up(c), cRight = rightOf(q, H(0), H(c));
+            if(up0){
+                if(upc && cRight) lo = c + 1;
+                else hi = c;
+            }
+            else{
+                if(!upc && cRight) hi = c;
+                else lo = c + 1;
+            }
+        }
+        r = lo;
+    }
+    // Si el siguiente vertice es colineal con q y mas lejano se prefiere ese
+    if(fabs(cross(H(r) - q, H(r+1) - q)) <= EPS && sqnorm(H(r+1) - q) > sqnorm(H(r) - q)) r++;
+    return (r % k + k) % k;
+}
+
+// Paso de envoltura: de los candidatos distintos de q se queda con el que deja a todos a su
+// izquierda (el mas lejano si hay colineales)
+void wrapStep(Point q, Point c, Point &best, bool &found){
+    if(c == q) return;
+    if(!found){ best = c; found = true; return; }
+    double o = cross(best - q, c - q);
+    if(o < -EPS || (fabs(o) <= EPS && sqnorm(c - q) > sqnorm(best - q))) best = c;
+}
+
+// Chan: envolventes de grupos de m puntos y a lo mas m pasos de Jarvis, donde el siguiente
+// vertice se busca con una tangente binaria por grupo. Se prueba m = 2^2^t hasta que m >= h,
+// O(n log h) en total.
+vector<Point> chanHull(vector<Point> &p){
+    int n = sz(p);
+    if(n == 0) return p;
+    int start = 0;
+    for(int i = 1; i < n; i++) if(p[i] < p[start]) start = i;
+    Point s = p[start];
+
+    for(int t = 1; ; t++){
+        long long m = t >= 6 ? n : min<long long>(n, 1LL << (1 << t));
+        // Envolventes de los grupos, guardadas una tras otra en h
+        vector<Point> h;
+        vector<int> off, len;
+        for(long long a = 0; a < n; a += m){
+            long long b = min<long long>(n, a + m);
+            vector<Point> g(p.begin() + a, p.begin() + b);
+            sort(g.begin(), g.end());
+            vector<Point> gh = hullFromSorted(g);
+            if(sz(gh) > 1 && gh.front() == gh.back()) gh.pop_back();
+            off.push_back(sz(h));
+            len.push_back(sz(gh));
+            h.insert(h.end(), gh.begin(), gh.end());
+        }
+
+        vector<Point> CH = {s};
+        Point q = s;
+        bool closed = false;
+        for(long long step = 0; step < m; step++){
+            Point best;
+            bool found = false;
+            for(int g = 0; g < sz(off); g++){
+                if(len[g] < 3){
+                    for(int i = 0; i < len[g]; i++) wrapStep(q, h[off[g] + i], best, found);
+                }
+                else{
+                    wrapStep(q, h[off[g] + hullTangent(h, off[g], len[g], q)], best, found);
+                }
+            }
+            if(!found || best == s){ closed = true; break; }
+            CH.push_back(best);
+            q = best;
+        }
+        if(closed) return CH;
+        if(m == n){
+            // Solo pasa si EPS hace inconsistentes las orientaciones (puntos casi colineales)
+            vector<Point> q = p;
+            sort(q.begin(), q.end());
+            return hullFromSorted(q);
+        }
+    }
+}
+
+// Cadena monotona en paralelo: cada hilo ordena su bloque y calcula su envolvente, y luego
+// se combinan con mergeHulls en O(h)
+vector<Point> monotoneChainParallel(vector<Point> &p, int threads = 0){
+    int n = sz(p);
+    if(threads <= 0) threads = max(1u, thread::hardware_concurrency());
+    threads = max(1, min(threads, n / 50000 + 1));
+
+    vector<vector<Point>> part(threads);
+    vector<thread> pool;
+    for(int t = 0; t < threads; t++){
+        pool.emplace_back([&, t]{
+            long long a = (long long)n * t / threads, b = (long long)n * (t+1) / threads;
+            sort(p.begin() + a, p.begin() + b);
+            part[t] = hullFromSorted(vector<Point>(p.begin() + a, p.begin() + b));
+        });
+    }
+    for(auto &th : pool) th.join();
+
+    vector<Point> CH = part[0];
+    for(int t = 1; t < threads; t++) CH = mergeHulls(CH, part[t]);
+    return CH;
+}
+
+// Lo que se estimo de la entrada y el algoritmo escogido, para el gancho de instrumentacion
+struct HullChoice{
+    const char* algorithm;
+    int n, sample, sampleHull;
+    double estimatedHull;     // Vertices estimados de la envolvente completa
+    double interiorFraction;  // Fraccion de la muestra dentro del octagono de sus extremos
+    bool integral;
+};
+
+// Umbrales del despachador. Los valores por omision salen de la seccion de calibracion de
+// Benchmarks.cpp y se pueden cambiar modificando hullConfig o pasando otra configuracion.
+// En esas mediciones QuickHull gano siempre que la nube tiene algo de interior (cuadrado,
+// disco, triangulo y hasta un anillo delgado, con 2% de la muestra adentro), la cadena monotona
+// cuando casi todo esta en la envolvente (circulo), Jarvis a la cadena monotona cuando no hay
+// interior pero h es chica (el borde de un octagono), y Chan nunca le gano a ninguno en un solo
+// nucleo, por eso viene apagado.
+struct HullConfig{
+    int sampleSize = 4096;            // A lo mas n/16 puntos de muestra
+    int smallN = 64;                  // Abajo de esto siempre cadena monotona
+    double jarvisMaxHull = 24;        // Jarvis si h estimada <= esto (la estimacion se pasa un poco)
+    double chanMaxHull = 0;           // Chan si h estimada <= esto y n >= chanMinN
+    int chanMinN = 1 << 20;
+    double quickHullMinInterior = 0.02;    // QuickHull si la muestra descarta al menos esta fraccion
+    double quickHullMaxHullFraction = 0.1; // y h estimada <= esta fraccion de n
+    int parallelMinN = 200000;        // Cadena monotona en paralelo desde este n
+    int threads = 0;                  // 0 = hardware_concurrency
+    function<void(const HullChoice&)> log;
+};
+
+HullConfig hullConfig;
+
+// Jarvis con el mismo paso que Chan y a lo mas maxHull vertices. Regresa vacio si no cerro
+// (h era mas grande que lo estimado) o si cerro dejando puntos afuera: con puntos casi
+// colineales EPS hace inconsistentes las orientaciones y el paso puede saltarse vertices, asi
+// que antes de regresar se revisa que todos queden del lado de adentro de cada arista, O(nh)
+vector<Point> jarvisBounded(const vector<Point> &p, int maxHull){
+    int start = 0;
+    for(int i = 1; i < sz(p); i++) if(p[i] < p[start]) start = i;
+    Point s = p[start], q = s;
+    vector<Point> CH = {s};
+    bool closed = false;
+    for(int step = 0; step < maxHull && !closed; step++){
+        Point best;
+        bool found = false;
+        for(const Point &c : p) wrapStep(q, c, best, found);
+        if(!found || best == s) closed = true;
+        else{
+            CH.push_back(best);
+            q = best;
+        }
+    }
+    if(!closed) return {};
+    for(int i = 0; i < sz(CH); i++){
+        Point a = CH[i], b = CH[(i+1) % sz(CH)];
+        for(const Point &c : p) if(cross(b - a, c - a) < -EPS) return {};
+    }
+    return CH;
+}
+
+// Estima de una muestra el tamaño de la envolvente, si las coordenadas son enteras y que
+// tanto de la nube queda dentro de sus extremos, y con eso escoge el algoritmo
+vector<Point> convexHull(vector<Point> &p, const HullConfig &cfg = hullConfig){
+    int n = sz(p);
+    HullChoice c{"monotoneChain", n, 0, 0, 0, 0, false};
+    auto done = [&](const char* name){
+        c.algorithm = name;
+        if(cfg.log) cfg.log(c);
+    };
+
+    if(n < max(cfg.smallN, 3)){
+        done("monotoneChain");
+        vector<Point> s = p;
+        sort(s.begin(), s.end());
+        return hullFromSorted(s);
+    }
+
+    // Muestra con paso fijo, asi es determinista
+    int s = max(3, min(cfg.sampleSize, n / 16));
+    vector<Point> sample(s);
+    for(int i = 0; i < s; i++) sample[i] = p[(long long)i * n / s];
+    c.sample = s;
+    c.integral = isIntegral(sample);
+    sort(sample.begin(), sample.end());
+    vector<Point> sh = hullFromSorted(sample);
+    c.sampleHull = sz(sh);
+
+    // Si la mayoria de la muestra esta en la envolvente, h crece como n; si no, se supone
+    // crecimiento logaritmico como en una nube uniforme
+    if(c.sampleHull * 2 > s) c.estimatedHull = (double)c.sampleHull * n / s;
+    else c.estimatedHull = c.sampleHull * log((double)n) / log((double)s);
+
+    // Extremos en 8 direcciones (ejes y diagonales): con solo los 4 de los ejes el cuadrilatero
+    // depende de donde caen sobre cada lado y en un cuadrado puede dejar fuera la mitad de la nube
+    const Point dirs[8] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {-1, -1}, {1, -1}, {-1, 1}};
+    int ext[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    for(int i = 1; i < s; i++){
+        for(int d = 0; d < 8; d++){
+            if(dot(sample[i], dirs[d]) > dot(sample[ext[d]], dirs[d])) ext[d] = i;
+        }
+    }
+    vector<Point> poly;
+    for(int e : ext) poly.push_back(sample[e]);
+    sort(poly.begin(), poly.end());
+    poly.erase(unique(poly.begin(), poly.end()), poly.end());
+    poly = hullFromSorted(poly);
+    int inside = 0;
+    for(const Point &q : sample){
+        bool in = sz(poly) >= 3;
+        for(int i = 0; in && i < sz(poly); i++) in = ccw(poly[i], poly[(i+1) % sz(poly)], q);
+        inside += in;
+    }
+    c.interiorFraction = (double)inside / s;
+
+    if(c.interiorFraction >= cfg.quickHullMinInterior && c.estimatedHull <= cfg.quickHullMaxHullFraction * n){
+        done("quickHull");
+        return quickHull(p);
+    }
+    if(c.estimatedHull <= cfg.jarvisMaxHull){
+        // Con el doble de lo que se permite estimar como tope; si no alcanza sigue abajo
+        vector<Point> CH = jarvisBounded(p, 2 * cfg.jarvisMaxHull);
+        if(!CH.empty()){
+            done("jarvisMarch");
+            return CH;
+        }
+    }
+    if(c.estimatedHull <= cfg.chanMaxHull && n >= cfg.chanMinN){
+        done("chanHull");
+        return chanHull(p);
+    }
+    int threads = cfg.threads > 0 ? cfg.threads : max(1u, thread::hardware_concurrency());
+    if(n >= cfg.parallelMinN && threads > 1){
+        done("monotoneChainParallel");
+        return monotoneChainParallel(p, threads);
+    }
+    if(c.integral && isIntegral(p)){
+        done("monotoneChainInt");
+        return monotoneChainDispatch(p);
+    }
+    done("monotoneChain");
+    sort(p.begin(), p.end());
+    return hullFromSorted(p);
+}
+#endif
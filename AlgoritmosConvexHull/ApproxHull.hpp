@@ -0,0 +1,109 @@
+/*Envolvente convexa aproximada en tiempo lineal (Bentley, Faust y Preparata)*/
+#ifndef APPROX_HULL
+#define APPROX_HULL
+#include "ConvexHulls.hpp"
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+// Se divide el rango en x en k franjas verticales y de cada franja solo se guardan el punto
+// mas bajo y el mas alto, ademas de los extremos en x. La envolvente de esos a lo mas 2k+4
+// puntos queda dentro de la envolvente real y todo punto de la entrada esta a distancia
+// menor o igual a (xmax - xmin)/k de ella, es decir, el error relativo al ancho es 1/k.
+// La pasada sobre los n puntos es O(n) y se reparte entre hilos; lo demas es O(k log k).
+
+struct StripExtremes{
+    vector<int> lo, hi;   // Indice del punto mas bajo y mas alto de cada franja, -1 si vacia
+    int left = -1, leftTop = -1, right = -1, rightTop = -1;
+};
+
+vector<Point> approxHull(const vector<Point> &p, int k, int threads = 0){
+    int n = sz(p);
+    if(n < 3 || k < 1){
+        vector<Point> s = p;
+        sort(s.begin(), s.end());
+        return hullFromSorted(s);
+    }
+    if(threads <= 0) threads = max(1u, thread::hardware_concurrency());
+    threads = max(1, min(threads, n / 50000 + 1));
+
+    // Primera pasada: rango en x
+    vector<double> mins(threads, p[0].x), maxs(threads, p[0].x);
+    vector<thread> pool;
+    auto chunk = [&](int t){ return make_pair((long long)n * t / threads, (long long)n * (t+1) / threads); };
+    for(int t = 0; t < threads; t++){
+        pool.emplace_back([&, t]{
+            // En locales: mins y maxs de hilos vecinos comparten linea de cache
+            auto [a, b] = chunk(t);
+            double lo = p[0].x, hi = p[0].x;
+            for(long long i = a; i < b; i++){
+                lo = min(lo, p[i].x);
+                hi = max(hi, p[i].x);
+            }
+            mins[t] = lo;
+            maxs[t] = hi;
+        });
+    }
+    for(auto &th : pool) th.join();
+    pool.clear();
+    double xmin = *min_element(mins.begin(), mins.end());
+    double xmax = *max_element(maxs.begin(), maxs.end());
+    double scale = xmax > xmin ? k / (xmax - xmin) : 0.0;
+
+    // Segunda pasada: extremos de cada franja, cada hilo con su propia copia
+    vector<StripExtremes> part(threads);
+    for(int t = 0; t < threads; t++){
+        pool.emplace_back([&, t]{
+            StripExtremes &s = part[t];
+            s.lo.assign(k, -1);
+            s.hi.assign(k, -1);
+            auto [a, b] = chunk(t);
+            // Los extremos en x tambien en locales, por la misma razon que en la primera pasada
+            int left = -1, leftTop = -1, right = -1, rightTop = -1;
+            for(long long i = a; i < b; i++){
+                int j = min(k-1, (int)((p[i].x - xmin) * scale));
+                if(s.lo[j] < 0 || p[i].y < p[s.lo[j]].y) s.lo[j] = i;
+                if(s.hi[j] < 0 || p[i].y > p[s.hi[j]].y) s.hi[j] = i;
+                if(left < 0 || p[i].x < p[left].x || (p[i].x == p[left].x && p[i].y < p[left].y)) left = i;
+                if(leftTop < 0 || p[i].x < p[leftTop].x || (p[i].x == p[leftTop].x && p[i].y > p[leftTop].y)) leftTop = i;
+                if(right < 0 || p[i].x > p[right].x || (p[i].x == p[right].x && p[i].y < p[right].y)) right = i;
+                if(rightTop < 0 || p[i].x > p[rightTop].x || (p[i].x == p[rightTop].x && p[i].y > p[rightTop].y)) rightTop = i;
+            }
+            s.left = left;
+            s.leftTop = leftTop;
+            s.right = right;
+            s.rightTop = rightTop;
+        });
+    }
+    for(auto &th : pool) th.join();
+
+    // Reducción de las copias y envolvente de los candidatos
+    vector<Point> cand;
+    for(int j = 0; j < k; j++){
+        int lo = -1, hi = -1;
+        for(int t = 0; t < threads; t++){
+            int a = part[t].lo[j], b = part[t].hi[j];
+            if(a >= 0 && (lo < 0 || p[a].y < p[lo].y)) lo = a;
+            if(b >= 0 && (hi < 0 || p[b].y > p[hi].y)) hi = b;
+        }
+        if(lo >= 0) cand.push_back(p[lo]);
+        if(hi >= 0 && hi != lo) cand.push_back(p[hi]);
+    }
+    for(int t = 0; t < threads; t++){
+        cand.push_back(p[part[t].left]);
+        cand.push_back(p[part[t].leftTop]);
+        cand.push_back(p[part[t].right]);
+        cand.push_back(p[part[t].rightTop]);
+    }
+    return monotoneChain(cand);
+}
+
+// Lo mismo pero con el error relativo eps en lugar del numero de franjas
+vector<Point> approxHullEps(const vector<Point> &p, double eps, int threads = 0){
+    int k = (int)min(1e7, ceil(1.0 / max(eps, 1e-7)));
+    return approxHull(p, k, threads);
+}
+#endif
@@ -0,0 +1,201 @@
+#include "ConvexHulls.hpp"
+#include "KineticHull.hpp"
+#include "IntHull.hpp"
+#include "ApproxHull.hpp"
+#include "ConvexLayers.hpp"
+#include "Skyline.hpp"
+#include "AdaptiveHull.hpp"
+#include <bits/stdc++.h>
+using namespace std;
+
+// Mide el tiempo en milisegundos de una función
+template<class F>
+double timeMs(F&& f){
+    auto start = chrono::steady_clock::now();
+    f();
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+// Compara la envolvente cinetica contra recalcular con monotoneChain en cada frame
+void benchKinetic(int n, int frames, double dt){
+    vector<MovingPoint> mp;
+    for(int i = 0; i < n; i++){
+        Point p(-1 + 2.0*rand()/RAND_MAX, -1 + 2.0*rand()/RAND_MAX);
+        Point v(-1 + 2.0*rand()/RAND_MAX, -1 + 2.0*rand()/RAND_MAX);
+        mp.push_back({p, v});
+    }
+
+    long long checksumK = 0, checksumM = 0;
+    double kinetic = timeMs([&]{
+        KineticHull kh(mp);
+        for(int f = 1; f <= frames; f++){
+            kh.advance(f*dt);
+            checksumK += sz(kh.hull());
+        }
+        cout << "  eventos: " << kh.events << ", reconstrucciones: " << kh.rebuilds << '\n';
+    });
+
+    vector<Point> p(n);
+    double recompute = timeMs([&]{
+        for(int f = 1; f <= frames; f++){
+            for(int i = 0; i < n; i++) p[i] = mp[i].at(f*dt);
+            checksumM += sz(monotoneChain(p));
+        }
+    });
+
+    cout << "  n = " << n << ", frames = " << frames
+         << ": cinetica " << kinetic << " ms, monotoneChain " << recompute << " ms"
+         << (checksumK == checksumM ? "" : "  (las envolventes no coinciden!)") << '\n';
+}
+
+// Compara el kernel entero y la envolvente por columnas contra la cadena monotona con doubles
+void benchInteger(int n, int W){
+    vector<Point> p(n);
+    vector<IPoint> q(n);
+    for(int i = 0; i < n; i++){
+        q[i] = IPoint(rand() % W, rand() % W);
+        p[i] = Point(q[i].x, q[i].y);
+    }
+    vector<Point> a = p, b = p;
+    vector<IPoint> c = q;
+    int h1 = 0, h2 = 0, h3 = 0;
+    double tDouble = timeMs([&]{ h1 = sz(monotoneChain(a)); });
+    double tInt = timeMs([&]{ h2 = sz(monotoneChainDispatch(b)); });
+    double tColumn = timeMs([&]{ h3 = sz(columnHull(c, W)); });
+    cout << "  n = " << n << ", W = " << W << ": double " << tDouble << " ms, entero " << tInt
+         << " ms, por columnas " << tColumn << " ms"
+         << (h1 == h2 && h2 == h3 ? "" : "  (las envolventes no coinciden!)") << '\n';
+}
+
+// Envolvente aproximada con k franjas contra la exacta
+void benchApprox(int n, int k){
+    vector<Point> p = randomPoints(n), a = p;
+    int h1 = 0, h2 = 0;
+    double tExact = timeMs([&]{ h1 = sz(monotoneChain(a)); });
+    double tApprox = timeMs([&]{ h2 = sz(approxHull(p, k)); });
+    cout << "  n = " << n << ", k = " << k << ": exacta " << tExact << " ms (" << h1 << " vertices), aproximada "
+         << tApprox << " ms (" << h2 << " vertices)\n";
+}
+
+// Capas convexas con los arboles dinamicos contra quitar capas con la cadena monotona.
+// Coordenadas enteras con copias repetidas para probar colineales y duplicados punto por punto
+void benchLayers(int n){
+    vector<Point> p(n);
+    for(int i = 0; i < n; i++) p[i] = Point(rand() % 1000, rand() % 1000);
+    for(int i = 0; i < n/10; i++) p.push_back(p[rand() % n]);
+    vector<int> layer;
+    double tTree = timeMs([&]{ layer = convexLayers(p); });
+    map<Point, int> naive;
+    double tNaive = timeMs([&]{
+        vector<Point> rest = p;
+        sort(rest.begin(), rest.end());
+        rest.erase(unique(rest.begin(), rest.end(), [](Point a, Point b){ return a.x == b.x && a.y == b.y; }), rest.end());
+        for(int depth = 0; !rest.empty(); depth++){
+            vector<Point> h = sz(rest) < 3 ? rest : hullFromSorted(rest);
+            set<Point> on(h.begin(), h.end());
+            vector<Point> next;
+            for(Point q : rest){
+                if(on.count(q)) naive[q] = depth;
+                else next.push_back(q);
+            }
+            rest = next;
+        }
+    });
+    int wrong = 0;
+    for(int i = 0; i < sz(p); i++) wrong += layer[i] != naive[p[i]];
+    int layers = *max_element(layer.begin(), layer.end()) + 1;
+    cout << "  n = " << sz(p) << ": arboles " << tTree << " ms, pelando con monotoneChain " << tNaive << " ms ("
+         << layers << " capas" << (wrong ? ", " + to_string(wrong) + " puntos no coinciden!" : "") << ")\n";
+}
+
+// Skyline sensible a la salida y en paralelo contra ordenar y recorrer
+void benchSkyline(int n){
+    vector<Point> p = randomPoints(n);
+    int h1 = 0, h2 = 0, h3 = 0;
+    double tSort = timeMs([&]{ vector<Point> s = p; sort(s.begin(), s.end()); h1 = sz(skylineFromSorted(s)); });
+    double tKS = timeMs([&]{ h2 = sz(skyline(p)); });
+    double tPar = timeMs([&]{ h3 = sz(skylineParallel(p)); });
+    cout << "  n = " << n << ": ordenar " << tSort << " ms, O(n log h) " << tKS << " ms, paralelo " << tPar << " ms"
+         << (h1 == h2 && h2 == h3 ? "" : "  (los skylines no coinciden!)") << '\n';
+}
+
+// Calibracion de hullConfig: tiempo de cada algoritmo por distribucion y lo que escoge convexHull
+void benchDispatch(int n, const string &kind){
+    vector<Point> p(n);
+    for(int i = 0; i < n; i++){
+        double a = 2*PI*rand()/RAND_MAX, r = (double)rand()/RAND_MAX;
+        if(kind == "cuadrado") p[i] = Point(r, (double)rand()/RAND_MAX);
+        else if(kind == "disco") p[i] = Point(sqrt(r)*cos(a), sqrt(r)*sin(a));
+        else if(kind == "circulo") p[i] = Point(cos(a), sin(a));
+        else if(kind == "triangulo") p[i] = r + (double)rand()/RAND_MAX <= 1 ? Point(r, (double)rand()/RAND_MAX * (1 - r)) : Point(0, 0);
+        else if(kind == "anillo") p[i] = Point((1 - 0.05*r)*cos(a), (1 - 0.05*r)*sin(a));
+        else if(kind == "octagono"){
+            // Sobre el borde: no hay interior y h es chica
+            int s = rand() % 8;
+            p[i] = Point((1 - r)*cos(PI*s/4) + r*cos(PI*(s+1)/4), (1 - r)*sin(PI*s/4) + r*sin(PI*(s+1)/4));
+        }
+        else p[i] = Point(rand() % 4096, rand() % 4096);
+    }
+
+    vector<Point> a = p;
+    int h = sz(monotoneChain(a));
+    // Jarvis con tope: el de ConvexHulls.hpp puede no terminar con puntos casi colineales
+    vector<pair<string, function<vector<Point>(vector<Point>&)>>> algs = {
+        {"jarvis", [h](vector<Point> &q){ return jarvisBounded(q, 2*h + 8); }}, {"chan", chanHull}, {"quick", quickHull},
+        {"monotona", monotoneChain}, {"paralela", [](vector<Point> &q){ return monotoneChainParallel(q); }},
+        {"entera", monotoneChainDispatch}
+    };
+    string chosen;
+    HullConfig cfg = hullConfig;
+    cfg.log = [&](const HullChoice &c){ chosen = c.algorithm; };
+
+    cout << "  " << kind << ", n = " << n << ", h = " << h << ":";
+    for(auto &[name, f] : algs){
+        // Jarvis es O(nh), solo vale la pena medirlo con envolventes chicas
+        if(name == "jarvis" && h > 64) continue;
+        a = p;
+        double t = timeMs([&]{ f(a); });
+        cout << ' ' << name << ' ' << t << " ms";
+    }
+    a = p;
+    double t = timeMs([&]{ convexHull(a, cfg); });
+    cout << " | convexHull " << t << " ms (" << chosen << ")\n";
+}
+
+int main(void){
+    srand(12345);
+
+    cout << "Envolvente cinetica vs recalcular por frame\n";
+    for(int n : {1000, 10000, 100000}){
+        benchKinetic(n, 600, 1.0/60);
+    }
+
+    cout << "Coordenadas enteras\n";
+    for(int n : {100000, 1000000}){
+        benchInteger(n, 4096);
+    }
+
+    cout << "Envolvente aproximada\n";
+    for(int n : {1000000, 10000000}){
+        benchApprox(n, 256);
+    }
+
+    cout << "Capas convexas\n";
+    for(int n : {10000, 50000}){
+        benchLayers(n);
+    }
+
+    cout << "Skyline\n";
+    for(int n : {1000000, 10000000}){
+        benchSkyline(n);
+    }
+
+    cout << "Despachador convexHull\n";
+    for(int n : {10000, 1000000}){
+        for(string kind : {"cuadrado", "disco", "circulo", "triangulo", "anillo", "octagono", "enteros"}){
+            benchDispatch(n, kind);
+        }
+    }
+    return 0;
+}
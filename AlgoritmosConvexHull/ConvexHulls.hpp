@@ -0,0 +1,115 @@
+/*Algoritmos de envolvente convexa y utilidades para combinar envolventes*/
+#ifndef CONVEX_HULLS
+#define CONVEX_HULLS
+#include "../geo.hpp"
+#include "HullSteps.hpp"
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+using namespace std;
+
+// Función para generar puntos aleatorios
+vector<Point> randomPoints(int n){
+    vector<Point>points;
+    for(int i = 0; i < n; i++){
+        double xrand = 100 * (double)rand()/(RAND_MAX + 1.0);
+        double yrand = 100 * (double)rand()/(RAND_MAX + 1.0);
+
+        points.push_back({xrand, yrand});
+    }
+
+    return points;
+}
+
+inline bool isConvex(vector<Point> &p){
+    int n = sz(p);
+    if (n < 3) return false;
+    if (n == 3) return true;
+    int dir = 0;
+
+    for(int i = 0; i < n; i++){
+        if (orientation(p[i],p[(i+1) % n],p[(i+2) % n]) != 0) {
+            if (dir == 0) dir = (ccw(p[i],p[(i+1) % n],p[(i+2) % n]) > 0 ? 1 : -1);
+            else if ((ccw(p[i],p[(i+1) % n],p[(i+2) % n]) > 0 ? 1 : -1) != dir) return false;
+            else dir = ccw(p[i],p[(i+1) % n],p[(i+2) % n]);
+        }
+    }
+    return true;
+}
+
+// Los algoritmos estan en HullSteps.hpp como corrutinas; aqui se corren sin emitir pasos
+
+vector<Point> jarvisMarch(vector<Point> &p){
+    int n = sz(p);
+    if(n < 3){cout << "Es un(a) " << (n%2 ? "punto" : "linea") << '\n'; return p;}
+    if(n<=3) return p; // Si n = 3 es un triangulo.
+    vector<Point> CH;
+    jarvisMarchSteps(p, CH, false).run();
+    return CH;
+}
+
+vector<Point> grahamScan(vector<Point> &p){
+    int n = sz(p);
+    if(n < 3){cout << "Es un(a) " << (n%2 ? "punto" : "linea") << '\n'; return p;}
+    if(n<=3) return p; // Si n = 3 es un triangulo.
+    vector<Point> CH;
+    grahamScanSteps(p, CH, false).run();
+    return CH;
+}
+
+// Cadena monotona sobre puntos ya ordenados con operator<, en O(n).
+// Regresa la envolvente en sentido antihorario empezando por el menor punto.
+vector<Point> hullFromSorted(const vector<Point> &p){
+    vector<Point> CH;
+    monotoneChainSteps(p, CH, false).run();
+    return CH;
+}
+
+vector<Point> monotoneChain(vector<Point> &p){
+    int n = sz(p);
+    if(n < 3){cout << "Es un(a) " << (n%2 ? "punto" : "linea") << '\n'; return p;}
+    if(n==3) return p; // Si n = 3 es un triangulo.
+
+    sort(p.begin(), p.end());
+    return hullFromSorted(p);
+}
+
+// Vertices de un poligono convexo (en cualquier sentido) ordenados con operator<, en O(h).
+// Las dos cadenas entre el menor y el mayor vertice ya son monotonas, solo se mezclan.
+vector<Point> sortedHullVertices(const vector<Point> &h){
+    int n = sz(h);
+    if(n <= 2){
+        vector<Point> s = h;
+        sort(s.begin(), s.end());
+        return s;
+    }
+    int lo = 0, hi = 0;
+    for(int i = 1; i < n; i++){
+        if(h[i] < h[lo]) lo = i;
+        if(h[hi] < h[i]) hi = i;
+    }
+
+    vector<Point> a, b;
+    for(int i = lo; ; i = (i+1)%n){
+        a.push_back(h[i]);
+        if(i == hi) break;
+    }
+    for(int i = (lo-1+n)%n; i != hi; i = (i-1+n)%n){
+        b.push_back(h[i]);
+    }
+
+    vector<Point> s(sz(a)+sz(b));
+    merge(a.begin(), a.end(), b.begin(), b.end(), s.begin());
+    return s;
+}
+
+// Envolvente de la union de dos envolventes convexas en O(h1+h2)
+vector<Point> mergeHulls(const vector<Point> &A, const vector<Point> &B){
+    vector<Point> a = sortedHullVertices(A);
+    vector<Point> b = sortedHullVertices(B);
+    vector<Point> s(sz(a)+sz(b));
+    merge(a.begin(), a.end(), b.begin(), b.end(), s.begin());
+    return hullFromSorted(s);
+}
+#endif
@@ -0,0 +1,225 @@
+/*Capas convexas (pelado de cebolla) con una envolvente dinamica que solo borra*/
+#ifndef CONVEX_LAYERS
+#define CONVEX_LAYERS
+#include "ConvexHulls.hpp"
+#include <vector>
+#include <algorithm>
+#include <numeric>
+
+using namespace std;
+
+// Envolvente superior de los puntos activos, al estilo de Overmars y van Leeuwen: un arbol de
+// segmentos sobre los puntos ordenados por x donde cada nodo guarda solo el puente (bl, br)
+// entre las envolventes de sus dos hijos. La envolvente de un nodo es la de su hijo izquierdo
+// hasta bl y la del derecho desde br, asi que nunca se guarda explicitamente.
+// Recalcular un puente es un descenso simultaneo en los dos hijos en O(log n), y borrar un
+// punto recalcula los O(log n) puentes de su camino a la raiz.
+// Solo puede haber un punto activo por cada x (el de hasta arriba de su columna), asi la
+// envolvente no tiene aristas verticales.
+class UpperHullTree
+{
+  public:
+    // s ordenado por x; ySign = -1 da la envolvente inferior reflejando y
+    UpperHullTree(const vector<Point> &s, double ySign) : s(s), ySign(ySign){
+      n = sz(s);
+      size = 1;
+      while(size < n) size <<= 1;
+      on.assign(size, 0);
+      node.assign(size, {0, -1, -1});
+    }
+
+    // Activa o desactiva hojas; los puentes se recalculan de abajo hacia arriba en update()
+    void set(int i, bool active){
+      if(on[i] == active) return;
+      on[i] = active;
+      dirty.push_back((size + i) >> 1);
+    }
+
+    void update(){
+      // En el arreglo del heap los nodos de niveles mas profundos tienen indices mayores
+      while(!dirty.empty()){
+        sort(dirty.begin(), dirty.end(), greater<int>());
+        dirty.erase(unique(dirty.begin(), dirty.end()), dirty.end());
+        vector<int> level;
+        level.swap(dirty);
+        for(int v : level){
+          if(v < 1) continue;
+          pull(v);
+          if(v > 1) dirty.push_back(v >> 1);
+        }
+      }
+    }
+
+    // Indices (en s) de los vertices de la envolvente, de izquierda a derecha
+    void vertices(vector<int> &out) const{
+      if(count(1) == 0) return;
+      report(1, 0, n-1, out);
+    }
+
+  private:
+    const vector<Point> &s;
+    double ySign;
+    int n, size;
+    // Hojas activas bajo cada nodo interno y su puente (indices de hoja), juntos en memoria
+    struct Node{
+      int cnt, bl, br;
+    };
+    vector<char> on;        // Hojas activas
+    vector<Node> node;
+    vector<int> dirty;
+
+    Point P(int leaf) const { return Point(s[leaf].x, ySign * s[leaf].y); }
+    bool isLeaf(int v) const { return v >= size; }
+    int count(int v) const { return isLeaf(v) ? on[v - size] : node[v].cnt; }
+
+    // Baja hasta un nodo cuya envolvente tiene puente propio (o una hoja)
+    int norm(int v) const{
+      while(!isLeaf(v) && (count(2*v) == 0 || count(2*v+1) == 0)){
+        v = count(2*v) ? 2*v : 2*v+1;
+      }
+      return v;
+    }
+
+    // x de la ultima hoja del hijo izquierdo, separa los dos hijos
+    double separator(int v) const{
+      int depth = 31 - __builtin_clz(v);
+      int span = size >> depth;
+      int last = (v - (1 << depth)) * span + span/2 - 1;
+      return s[min(last, n-1)].x;
+    }
+
+    // q esta arriba o sobre la recta que pasa por a y b (a.x < b.x)
+    static bool aboveOrOn(Point q, Point a, Point b){
+      return cross(b - a, q - a) >= 0;
+    }
+
+    static double lineAt(Point a, Point b, double x){
+      return a.y + (b.y - a.y) * (x - a.x) / (b.x - a.x);
+    }
+
+    void pull(int v){
+      node[v].cnt = count(2*v) + count(2*v+1);
+      if(count(2*v) == 0 || count(2*v+1) == 0) return;
+
+      int a = norm(2*v), b = norm(2*v+1);
+      double m = separator(v);
+      while(!isLeaf(a) || !isLeaf(b)){
+        if(isLeaf(a)){
+          if(aboveOrOn(P(a - size), P(node[b].bl), P(node[b].br))) b = norm(2*b+1);
+          else b = norm(2*b);
+          continue;
+        }
+        Point a1 = P(node[a].bl), a2 = P(node[a].br);
+        if(isLeaf(b)){
+          if(aboveOrOn(P(b - size), a1, a2)) a = norm(2*a);
+          else a = norm(2*a+1);
+          continue;
+        }
+        Point b1 = P(node[b].bl), b2 = P(node[b].br);
+        // La arista de a queda tapada por b: el puente sale antes de a1
+        if(aboveOrOn(b1, a1, a2) || aboveOrOn(b2, a1, a2)) { a = norm(2*a); continue; }
+        // La arista de b queda tapada por a: el puente llega despues de b2
+        if(aboveOrOn(a1, b1, b2) || aboveOrOn(a2, b1, b2)) { b = norm(2*b+1); continue; }
+        // Ninguna tapa a la otra: el lado del separador donde se cruzan sus rectas decide
+        double la = lineAt(a1, a2, m), lb = lineAt(b1, b2, m);
+        if(la >= lb) a = norm(2*a+1);
+        if(la <= lb) b = norm(2*b);
+      }
+      node[v].bl = a - size;
+      node[v].br = b - size;
+    }
+
+    // Vertices de la envolvente del nodo v con indice de hoja en [lo, hi]
+    void report(int v, int lo, int hi, vector<int> &out) const{
+      v = norm(v);
+      if(isLeaf(v)){
+        int i = v - size;
+        if(lo <= i && i <= hi) out.push_back(i);
+        return;
+      }
+      if(lo <= node[v].bl) report(2*v, lo, min(hi, node[v].bl), out);
+      if(hi >= node[v].br) report(2*v+1, max(lo, node[v].br), hi, out);
+    }
+};
+
+// Capa convexa de cada punto: 0 para los vertices de la envolvente, 1 para los de la envolvente
+// de los que quedan, etc. Los puntos que caen sobre una arista sin ser vertice pasan a la
+// siguiente capa. Los puntos repetidos quedan en la misma capa. Cada punto se borra una vez de
+// dos arboles, O(n log^2 n) en total.
+vector<int> convexLayers(const vector<Point> &p){
+  int total = sz(p);
+  vector<int> result(total, -1);
+  if(total == 0) return result;
+
+  vector<int> sorted(total);
+  iota(sorted.begin(), sorted.end(), 0);
+  sort(sorted.begin(), sorted.end(), [&](int a, int b){
+    return p[a].x < p[b].x || (p[a].x == p[b].x && p[a].y < p[b].y);
+  });
+  // Las copias exactas de un punto se calculan una sola vez: en una columna solo esta activo un
+  // punto, asi que la segunda copia saldria una capa despues y moveria a los demas
+  vector<int> order, rep(total);
+  for(int k = 0; k < total; k++){
+    int i = sorted[k];
+    if(order.empty() || p[i].x != p[order.back()].x || p[i].y != p[order.back()].y) order.push_back(i);
+    rep[i] = sz(order) - 1;
+  }
+  int n = sz(order);
+  vector<int> layer(n, -1);
+  vector<Point> s(n);
+  for(int i = 0; i < n; i++) s[i] = p[order[i]];
+
+  // Columnas de puntos con la misma x; en cada una solo esta activo el de arriba (o el de abajo)
+  vector<int> col(n), colStart, top, bottom;
+  for(int i = 0; i < n; i++){
+    if(i == 0 || s[i].x != s[i-1].x){
+      colStart.push_back(i);
+      bottom.push_back(i);
+      top.push_back(i);
+    }
+    col[i] = sz(colStart) - 1;
+    top.back() = i;
+  }
+
+  UpperHullTree upper(s, 1.0), lower(s, -1.0);
+  for(int c = 0; c < sz(colStart); c++){
+    upper.set(top[c], true);
+    lower.set(bottom[c], true);
+  }
+  upper.update();
+  lower.update();
+
+  vector<char> alive(n, 1);
+  int remaining = n;
+  vector<int> hull;
+  for(int depth = 0; remaining > 0; depth++){
+    hull.clear();
+    upper.vertices(hull);
+    lower.vertices(hull);
+    for(int i : hull){
+      if(!alive[i]) continue;
+      alive[i] = 0;
+      layer[i] = depth;
+      remaining--;
+    }
+    for(int i : hull){
+      int c = col[i];
+      if(top[c] == i){
+        upper.set(i, false);
+        while(top[c] >= colStart[c] && !alive[top[c]]) top[c]--;
+        if(top[c] >= colStart[c]) upper.set(top[c], true);
+      }
+      int end = (c + 1 < sz(colStart) ? colStart[c+1] : n);
+      if(bottom[c] == i){
+        lower.set(i, false);
+        while(bottom[c] < end && !alive[bottom[c]]) bottom[c]++;
+        if(bottom[c] < end) lower.set(bottom[c], true);
+      }
+    }
+    upper.update();
+    lower.update();
+  }
+  for(int i = 0; i < total; i++) result[i] = layer[rep[i]];
+  return result;
+}
+#endif
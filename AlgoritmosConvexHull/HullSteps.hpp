@@ -0,0 +1,230 @@
+/*Algoritmos de envolvente convexa como corrutinas que generan sus pasos (C++20)*/
+#ifndef HULL_STEPS
+#define HULL_STEPS
+#include "../geo.hpp"
+#include <coroutine>
+#include <exception>
+#include <utility>
+#include <vector>
+#include <algorithm>
+
+using namespace std;
+
+// Cada algoritmo escribe la envolvente en CH conforme avanza y, si emit es verdadero, se
+// detiene en cada paso con un evento. Con emit en falso nunca se suspende: la primera
+// llamada a next() corre todo el algoritmo, asi que las mismas funciones sirven para
+// calcular la envolvente a toda velocidad y para animarla.
+// Los ciclos internos tienen una rama sin co_yield para emit en falso: las variables que
+// viven a traves de una suspension quedan en el marco de la corrutina y no en registros,
+// y eso hacia a Jarvis ~50% mas lento. La decision de cada paso es la misma funcion en
+// ambas ramas.
+
+// Con HULL_COUNTERS definido antes de incluir, cada hilo cuenta sus pruebas de orientacion
+// y sus pops en hullCounters (lo usa el modo carrera); sin el, HULL_COUNT no genera codigo.
+#ifdef HULL_COUNTERS
+struct HullCounters{
+    long long orientationTests = 0, pops = 0;
+};
+inline thread_local HullCounters hullCounters;
+#define HULL_COUNT(c) (hullCounters.c++)
+#else
+#define HULL_COUNT(c) ((void)0)
+#endif
+
+enum HullStepKind{
+    COMPARE,    // Se compara b contra c (el mejor hasta ahora) desde a
+    PUSH,       // a entra a la envolvente
+    POP,        // a sale de la envolvente
+    DONE
+};
+
+struct HullStep{
+    HullStepKind kind;
+    Point a, b, c;
+};
+
+// Generador minimo: next() avanza al siguiente evento y regresa falso cuando ya termino
+template<class T>
+class Generator
+{
+  public:
+    struct promise_type{
+        T current;
+        exception_ptr error;
+
+        Generator get_return_object(){ return Generator(handle::from_promise(*this)); }
+        suspend_always initial_suspend() noexcept { return {}; }
+        suspend_always final_suspend() noexcept { return {}; }
+        suspend_always yield_value(T v){
+            current = move(v);
+            return {};
+        }
+        void return_void(){}
+        void unhandled_exception(){ error = current_exception(); }
+    };
+    using handle = coroutine_handle<promise_type>;
+
+    Generator() : h(nullptr) {}
+    Generator(Generator &&o) noexcept : h(exchange(o.h, nullptr)) {}
+    Generator& operator=(Generator &&o) noexcept{
+        if(this != &o){
+            if(h) h.destroy();
+            h = exchange(o.h, nullptr);
+        }
+        return *this;
+    }
+    Generator(const Generator&) = delete;
+    Generator& operator=(const Generator&) = delete;
+    ~Generator(){ if(h) h.destroy(); }
+
+    bool next(){
+        if(!h || h.done()) return false;
+        h.resume();
+        if(h.promise().error) rethrow_exception(h.promise().error);
+        return !h.done();
+    }
+    const T& value() const { return h.promise().current; }
+    bool done() const { return !h || h.done(); }
+
+    // Corre hasta el final sin ver los eventos
+    void run(){ while(next()); }
+
+  private:
+    handle h;
+    explicit Generator(handle h0) : h(h0) {}
+};
+
+// i mejora al candidato k visto desde el pivote; en el caso colineal se prefiere el mas lejano
+inline bool jarvisBetter(Point pivot, Point i, Point k){
+    HULL_COUNT(orientationTests);
+    int o = orientation(pivot, i, k);
+    return o == LEFT || (o == COLLINEAL && dist(pivot, i) > dist(pivot, k));
+}
+
+// Verdadero si q se puede agregar a la pila: tiene menos de lim puntos o hay vuelta a la izquierda
+inline bool turnsLeft(const vector<Point> &CH, int lim, Point q){
+    if(sz(CH) < lim) return true;
+    HULL_COUNT(orientationTests);
+    return ccw(CH[sz(CH)-2], CH.back(), q);
+}
+
+// Saca el tope de la pila
+inline void popHull(vector<Point> &CH){
+    HULL_COUNT(pops);
+    CH.pop_back();
+}
+
+// Jarvis: desde cada vertice escoge el punto que deja a todos los demas del mismo lado.
+// La envolvente queda en sentido horario empezando por el menor punto.
+Generator<HullStep> jarvisMarchSteps(const vector<Point> &p, vector<Point> &CH, bool emit){
+    int n = sz(p);
+    CH.clear();
+    if(n == 0) co_return;
+    int l = 0;
+    for(int i = 1; i < n; i++){
+        if(p[i] < p[l]) l = i;
+    }
+
+    int pivot = l, k;
+    do{
+        CH.push_back(p[pivot]);
+        if(emit) co_yield HullStep{PUSH, p[pivot], p[pivot], p[pivot]};
+        k = (pivot+1)%n;
+        if(!emit){
+            for(int i = 0; i < n; i++) if(i != pivot && jarvisBetter(p[pivot], p[i], p[k])) k = i;
+        }
+        else for(int i = 0; i < n; i++){
+            if(i == pivot) continue;
+            co_yield HullStep{COMPARE, p[pivot], p[i], p[k]};
+            if(jarvisBetter(p[pivot], p[i], p[k])) k = i;
+        }
+        pivot = k;
+    }while(!(p[pivot] == p[l])); // Compara puntos y no indices por si hay repetidos
+
+    if(emit) co_yield HullStep{DONE, p[l], p[l], p[l]};
+}
+
+// Graham: ordena por angulo alrededor del menor punto y usa CH como pila.
+// Reordena p; la envolvente queda en sentido antihorario.
+Generator<HullStep> grahamScanSteps(vector<Point> &p, vector<Point> &CH, bool emit){
+    int n = sz(p);
+    CH.clear();
+    if(n < 2){
+        CH = p;
+        co_return;
+    }
+    int l = 0;
+    for(int i = 1; i < n; i++){
+        if(p[i] < p[l]) l = i;
+    }
+
+    swap(p[0], p[l]);
+
+    sort(++p.begin(), p.end(),[&](Point a, Point b){
+        HULL_COUNT(orientationTests);
+        if (ccw(p[0], a, b)) return true;
+        HULL_COUNT(orientationTests);
+        if (ccw(p[0], b, a)) return false;
+
+        // Esto maneja el caso colineal, prefiriendo añadir mas puntos.
+        return dist(p[0], a) < dist(p[0], b);
+    });
+
+    for(int i = 0; i < 2; i++){
+        CH.push_back(p[i]);
+        if(emit) co_yield HullStep{PUSH, p[i], p[i], p[i]};
+    }
+    for(int i = 2; i < n; i++){
+        // Saca de la pila mientras no haya vuelta a la izquierda; nunca saca el punto inicial
+        if(!emit){
+            while(!turnsLeft(CH, 2, p[i])) popHull(CH);
+        }
+        else while(sz(CH) >= 2){
+            co_yield HullStep{COMPARE, CH[sz(CH)-2], p[i], CH.back()};
+            if(turnsLeft(CH, 2, p[i])) break;
+            Point top = CH.back();
+            popHull(CH);
+            co_yield HullStep{POP, top, top, top};
+        }
+        CH.push_back(p[i]);
+        if(emit) co_yield HullStep{PUSH, p[i], p[i], p[i]};
+    }
+    if(emit) co_yield HullStep{DONE, CH[0], CH[0], CH[0]};
+}
+
+// Cadena monotona sobre puntos ya ordenados con operator<, en O(n): cadena inferior y luego
+// superior. La envolvente queda en sentido antihorario empezando por el menor punto.
+Generator<HullStep> monotoneChainSteps(const vector<Point> &p, vector<Point> &CH, bool emit){
+    int n = sz(p);
+    CH.clear();
+    if(n <= 1){
+        CH = p;
+        co_return;
+    }
+    CH.reserve(2*n);
+
+    // Hace el hull inferior (lim = 2) y luego el superior (lim = t), sin tocar el inferior
+    for(int pass = 0, t = 2; pass < 2; pass++){
+        for(int j = 0; j < n - pass; j++){
+            Point q = pass == 0 ? p[j] : p[n-2-j];
+            if(!emit){
+                while(!turnsLeft(CH, t, q)) popHull(CH);
+            }
+            else while(sz(CH) >= t){
+                co_yield HullStep{COMPARE, CH[sz(CH)-2], q, CH.back()};
+                if(turnsLeft(CH, t, q)) break;
+                Point top = CH.back();
+                popHull(CH);
+                co_yield HullStep{POP, top, top, top};
+            }
+            CH.push_back(q);
+            if(emit) co_yield HullStep{PUSH, q, q, q};
+        }
+        t = sz(CH) + 1;
+    }
+
+    // El ultimo es otra vez el primero
+    CH.pop_back();
+    if(emit) co_yield HullStep{DONE, CH[0], CH[0], CH[0]};
+}
+#endif
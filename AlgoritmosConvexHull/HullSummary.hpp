@@ -0,0 +1,68 @@
+/*Resumen compacto de una envolvente convexa para pasarla entre procesos*/
+#ifndef HULL_SUMMARY
+#define HULL_SUMMARY
+#include "ConvexHulls.hpp"
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+using namespace std;
+
+// Formato: "HULL", cantidad de vertices (uint32) y luego x, y de cada vertice como double.
+// Se usa el orden de bytes de la maquina, la idea es intercambiarlo entre procesos locales.
+const char HULL_MAGIC[4] = {'H','U','L','L'};
+
+string serializeHull(const vector<Point> &h){
+    uint32_t n = h.size();
+    string buf(sizeof(HULL_MAGIC) + sizeof(n) + 2*sizeof(double)*n, '\0');
+    char* out = &buf[0];
+    memcpy(out, HULL_MAGIC, sizeof(HULL_MAGIC)); out += sizeof(HULL_MAGIC);
+    memcpy(out, &n, sizeof(n)); out += sizeof(n);
+    for(const Point &p : h){
+        memcpy(out, &p.x, sizeof(double)); out += sizeof(double);
+        memcpy(out, &p.y, sizeof(double)); out += sizeof(double);
+    }
+    return buf;
+}
+
+vector<Point> deserializeHull(const string &buf){
+    uint32_t n = 0;
+    if(buf.size() < sizeof(HULL_MAGIC) + sizeof(n) || memcmp(buf.data(), HULL_MAGIC, sizeof(HULL_MAGIC)) != 0){
+        throw runtime_error("Resumen de envolvente invalido");
+    }
+    const char* in = buf.data() + sizeof(HULL_MAGIC);
+    memcpy(&n, in, sizeof(n)); in += sizeof(n);
+    if(buf.size() != sizeof(HULL_MAGIC) + sizeof(n) + 2*sizeof(double)*n){
+        throw runtime_error("Resumen de envolvente truncado");
+    }
+    vector<Point> h(n);
+    for(uint32_t i = 0; i < n; i++){
+        memcpy(&h[i].x, in, sizeof(double)); in += sizeof(double);
+        memcpy(&h[i].y, in, sizeof(double)); in += sizeof(double);
+    }
+    return h;
+}
+
+void writeHullSummary(const string &path, const vector<Point> &h){
+    ofstream file(path, ios::binary);
+    if(!file.is_open()){
+        throw runtime_error("No se pudo escribir " + path);
+    }
+    string buf = serializeHull(h);
+    file.write(buf.data(), buf.size());
+}
+
+vector<Point> readHullSummary(const string &path){
+    ifstream file(path, ios::binary);
+    if(!file.is_open()){
+        throw runtime_error("No se encontro el archivo " + path);
+    }
+    stringstream ss;
+    ss << file.rdbuf();
+    return deserializeHull(ss.str());
+}
+#endif
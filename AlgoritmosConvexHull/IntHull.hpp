@@ -0,0 +1,141 @@
+/*Envolvente convexa exacta para coordenadas enteras*/
+#ifndef INT_HULL
+#define INT_HULL
+#include "ConvexHulls.hpp"
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+// Las coordenadas deben estar en [-2^30, 2^30), asi las diferencias caben en 31 bits,
+// cada producto en 62 y el producto cruz en int64 sin desbordarse. No hace falta EPS.
+const int64_t INT_HULL_LIMIT = 1LL << 30;
+
+struct IPoint{
+ int32_t x, y;
+ IPoint() : x(0), y(0) {}
+ IPoint(int32_t x0, int32_t y0) : x(x0), y(y0) {}
+};
+
+inline bool operator<(IPoint p, IPoint q){
+ return p.x < q.x || (p.x == q.x && p.y < q.y);
+}
+
+inline bool operator==(IPoint p, IPoint q){
+ return p.x == q.x && p.y == q.y;
+}
+
+inline int64_t cross64(IPoint o, IPoint a, IPoint b){
+ return ((int64_t)a.x - o.x) * ((int64_t)b.y - o.y) - ((int64_t)a.y - o.y) * ((int64_t)b.x - o.x);
+}
+
+// Signo exacto de la orientacion: 1 antihorario, -1 horario, 0 colineal
+inline int orientationInt(IPoint o, IPoint a, IPoint b){
+ int64_t c = cross64(o, a, b);
+ return (c > 0) - (c < 0);
+}
+
+// Ordena con una sola llave de 64 bits (x en la parte alta, y en la baja)
+void sortIPoints(vector<IPoint> &p){
+ int n = sz(p);
+ vector<uint64_t> keys(n);
+ for(int i = 0; i < n; i++){
+  keys[i] = ((uint64_t)((uint32_t)p[i].x ^ 0x80000000u) << 32) | ((uint32_t)p[i].y ^ 0x80000000u);
+ }
+ sort(keys.begin(), keys.end());
+ for(int i = 0; i < n; i++){
+  p[i].x = (int32_t)((uint32_t)(keys[i] >> 32) ^ 0x80000000u);
+  p[i].y = (int32_t)((uint32_t)keys[i] ^ 0x80000000u);
+ }
+}
+
+// Cadena monotona sobre puntos enteros ya ordenados
+vector<IPoint> hullFromSortedInt(const vector<IPoint> &p){
+ int n = sz(p);
+ if(n <= 1) return p;
+ int k = 0;
+ vector<IPoint> CH(2*n);
+
+ for(int i = 0; i < n; i++){
+  while(k >= 2 && cross64(CH[k-2], CH[k-1], p[i]) <= 0) --k;
+  CH[k++] = p[i];
+ }
+ for(int i = n-2, t = k+1; i >= 0; i--){
+  while(k >= t && cross64(CH[k-2], CH[k-1], p[i]) <= 0) --k;
+  CH[k++] = p[i];
+ }
+
+ CH.resize(k);
+ CH.pop_back();
+ return CH;
+}
+
+vector<IPoint> monotoneChainInt(vector<IPoint> &p){
+ sortIPoints(p);
+ return hullFromSortedInt(p);
+}
+
+// Envolvente de una mascara en O(n + W): para cada columna x en [0, W) solo pueden estar
+// en la envolvente el punto mas bajo y el mas alto, y recorrer las columnas ya da el orden.
+// Lanza invalid_argument si algun x queda fuera de [0, W).
+vector<IPoint> columnHull(const vector<IPoint> &p, int W){
+ if(W < 0) throw invalid_argument("columnHull: ancho negativo");
+ vector<int32_t> lo(W, INT32_MAX), hi(W, INT32_MIN);
+ for(const IPoint &q : p){
+  if(q.x < 0 || q.x >= W) throw invalid_argument("columnHull: x fuera de [0, W)");
+  lo[q.x] = min(lo[q.x], q.y);
+  hi[q.x] = max(hi[q.x], q.y);
+ }
+ vector<IPoint> s;
+ for(int x = 0; x < W; x++){
+  if(lo[x] > hi[x]) continue;
+  s.push_back({x, lo[x]});
+  if(hi[x] != lo[x]) s.push_back({x, hi[x]});
+ }
+ return hullFromSortedInt(s);
+}
+
+// Igual pero directo de una mascara W x H guardada por renglones (mask[y*W + x] != 0)
+vector<IPoint> maskHull(const vector<unsigned char> &mask, int W, int H){
+ if(W < 0 || H < 0 || mask.size() < (size_t)W*H) throw invalid_argument("maskHull: la mascara no es de W x H");
+ vector<int32_t> lo(W, INT32_MAX), hi(W, INT32_MIN);
+ for(int y = 0; y < H; y++){
+  const unsigned char* row = &mask[(size_t)y*W];
+  for(int x = 0; x < W; x++){
+   if(!row[x]) continue;
+   lo[x] = min(lo[x], y);
+   hi[x] = max(hi[x], y);
+  }
+ }
+ vector<IPoint> s;
+ for(int x = 0; x < W; x++){
+  if(lo[x] > hi[x]) continue;
+  s.push_back({x, lo[x]});
+  if(hi[x] != lo[x]) s.push_back({x, hi[x]});
+ }
+ return hullFromSortedInt(s);
+}
+
+// Verdadero si todas las coordenadas son enteras y caben en el rango del kernel entero
+bool isIntegral(const vector<Point> &p){
+ for(const Point &q : p){
+  if(q.x != floor(q.x) || q.y != floor(q.y)) return false;
+  if(q.x < -INT_HULL_LIMIT || q.x >= INT_HULL_LIMIT || q.y < -INT_HULL_LIMIT || q.y >= INT_HULL_LIMIT) return false;
+ }
+ return true;
+}
+
+// Usa el kernel entero si la entrada lo permite, si no la cadena monotona con doubles
+vector<Point> monotoneChainDispatch(vector<Point> &p){
+ if(sz(p) < 3 || !isIntegral(p)) return monotoneChain(p);
+ vector<IPoint> q(sz(p));
+ for(int i = 0; i < sz(p); i++) q[i] = IPoint((int32_t)p[i].x, (int32_t)p[i].y);
+ vector<IPoint> h = monotoneChainInt(q);
+ vector<Point> CH(sz(h));
+ for(int i = 0; i < sz(h); i++) CH[i] = Point(h[i].x, h[i].y);
+ return CH;
+}
+#endif
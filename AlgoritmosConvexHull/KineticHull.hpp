@@ -0,0 +1,336 @@
+/*Envolvente convexa cinetica para puntos con trayectorias lineales*/
+#ifndef KINETIC_HULL
+#define KINETIC_HULL
+#include "ConvexHulls.hpp"
+#include <vector>
+#include <queue>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+using namespace std;
+
+// Punto en movimiento: su posicion en el tiempo t es p0 + v*t
+struct MovingPoint{
+  Point p0, v;
+  MovingPoint() {}
+  MovingPoint(Point p, Point vel) : p0(p), v(vel) {}
+  Point at(double t) const { return p0 + v*t; }
+};
+
+// La envolvente se guarda como lista circular antihoraria y su interior se divide en un
+// abanico de triangulos desde un vertice fijo h0: T(v) = (h0, v, sig(v)).
+// Los certificados que prueban que la envolvente es correcta son:
+//  - cada vertice de la envolvente hace vuelta a la izquierda con sus vecinos,
+//  - cada punto interior esta dentro de su triangulo del abanico.
+// Cada certificado es un signo de orientacion, que para puntos lineales es un polinomio
+// cuadratico en t, asi que su tiempo de falla se calcula y se agenda en una cola de eventos.
+// Solo se hace trabajo cuando un certificado falla.
+class KineticHull
+{
+  public:
+    long long events = 0;    // Certificados que fallaron
+    long long rebuilds = 0;  // Reconstrucciones completas (h0 dejo de ser vertice)
+
+    KineticHull(const vector<MovingPoint>& pts, double t0 = 0.0) : mp(pts){
+      int n = sz(mp);
+      double scale = 1.0;
+      for(int i = 0; i < n; i++){
+        scale = max(scale, max(fabs(mp[i].p0.x), fabs(mp[i].p0.y)));
+        scale = max(scale, max(fabs(mp[i].v.x), fabs(mp[i].v.y)));
+      }
+      tol = 1e-12 * scale * scale;
+      nxt.assign(n, -1);
+      prv.assign(n, -1);
+      owner.assign(n, -1);
+      slot.assign(n, -1);
+      version.assign(n, 0);
+      buckets.assign(n, {});
+      build(t0);
+    }
+
+    double time() const { return now; }
+
+    // Avanza el tiempo procesando los certificados que fallan antes de t
+    void advance(double t){
+      if(t < now){
+        build(t);
+        return;
+      }
+      if(degenerate){
+        build(t);
+        return;
+      }
+      int sameInstant = 0;
+      double lastTime = now;
+      while(!pq.empty() && pq.top().t <= t){
+        Event ev = pq.top();
+        pq.pop();
+        if(ev.version != version[ev.id]) continue;
+        now = max(now, ev.t);
+
+        // Protección contra eventos simultaneos que se ciclan por redondeo
+        if(now == lastTime) sameInstant++;
+        else { sameInstant = 0; lastTime = now; }
+        if(sameInstant > 8*sz(mp) + 64){
+          build(now);
+          if(degenerate) break;
+          sameInstant = 0;
+          continue;
+        }
+
+        events++;
+        if(owner[ev.id] == HULL) convexityFailed(ev.id);
+        else leftTriangle(ev.id);
+        if(degenerate) break;
+      }
+      now = t;
+      if(degenerate) build(t);
+    }
+
+    // Envolvente en el tiempo actual, en sentido antihorario
+    vector<Point> hull() const{
+      if(degenerate){
+        vector<Point> p(sz(mp));
+        for(int i = 0; i < sz(mp); i++) p[i] = mp[i].at(now);
+        sort(p.begin(), p.end());
+        return hullFromSorted(p);
+      }
+      vector<Point> CH;
+      int v = h0;
+      do{
+        CH.push_back(mp[v].at(now));
+        v = nxt[v];
+      }while(v != h0);
+      return CH;
+    }
+
+    // Indices de los vertices de la envolvente, empezando por h0
+    vector<int> hullIds() const{
+      vector<int> ids;
+      if(degenerate) return ids;
+      int v = h0;
+      do{
+        ids.push_back(v);
+        v = nxt[v];
+      }while(v != h0);
+      return ids;
+    }
+
+  private:
+    static const int HULL = -2;
+
+    // Certificado: orientacion(a,b,c) = A*s^2 + B*s + C con s = t - now
+    struct Quad{
+      double a, b, c;
+    };
+    struct Event{
+      double t;
+      int id;
+      unsigned int version;
+      bool operator<(const Event& o) const { return t > o.t; }
+    };
+
+    vector<MovingPoint> mp;
+    vector<int> nxt, prv;           // Lista circular de la envolvente
+    vector<int> owner;              // HULL o el vertice v del triangulo T(v) que contiene al punto
+    vector<int> slot;               // Posicion del punto dentro de buckets[owner]
+    vector<vector<int>> buckets;    // Puntos interiores de cada triangulo del abanico
+    vector<unsigned int> version;   // Invalida los eventos viejos de cada punto
+    priority_queue<Event> pq;
+    int h0 = -1;
+    int hullSize = 0;
+    double now = 0.0;
+    double tol = 1e-12;
+    bool degenerate = false;
+
+    Quad orient(int a, int b, int c) const{
+      Point d1 = mp[b].at(now) - mp[a].at(now), d2 = mp[c].at(now) - mp[a].at(now);
+      Point e1 = mp[b].v - mp[a].v, e2 = mp[c].v - mp[a].v;
+      return {cross(e1, e2), cross(d1, e2) + cross(e1, d2), cross(d1, d2)};
+    }
+
+    // Signo del certificado justo despues de now
+    int signAfter(const Quad& q) const{
+      if(fabs(q.c) > tol) return q.c > 0 ? 1 : -1;
+      if(fabs(q.b) > tol) return q.b > 0 ? 1 : -1;
+      if(fabs(q.a) > tol) return q.a > 0 ? 1 : -1;
+      return 0;
+    }
+
+    // Primer instante (relativo a now) en que el certificado se vuelve negativo
+    double failTime(Quad q) const{
+      const double INF = numeric_limits<double>::infinity();
+      if(signAfter(q) < 0) return 0.0;
+      if(fabs(q.c) <= tol) q.c = 0.0;
+      if(fabs(q.a) <= tol){
+        if(q.b < 0) return max(0.0, -q.c / q.b);
+        return INF;
+      }
+      double disc = q.b*q.b - 4*q.a*q.c;
+      if(disc < 0) return q.a < 0 ? 0.0 : INF;
+      double sq = sqrt(disc);
+      double qq = -0.5 * (q.b + (q.b < 0 ? -sq : sq));
+      double r1 = qq / q.a;
+      double r2 = qq != 0.0 ? q.c / qq : 0.0;
+      if(r1 > r2) swap(r1, r2);
+      if(q.a > 0) return r2 <= 0 ? INF : max(r1, 0.0);
+      return max(r2, 0.0);
+    }
+
+    void schedule(int id, double dt){
+      version[id]++;
+      if(dt != numeric_limits<double>::infinity()){
+        pq.push({now + dt, id, version[id]});
+      }
+    }
+
+    void scheduleHull(int v){
+      schedule(v, failTime(orient(prv[v], v, nxt[v])));
+    }
+
+    void scheduleInterior(int i){
+      int v = owner[i], w = nxt[v];
+      double dt = failTime(orient(h0, v, i));
+      dt = min(dt, failTime(orient(v, w, i)));
+      dt = min(dt, failTime(orient(w, h0, i)));
+      schedule(i, dt);
+    }
+
+    void addToBucket(int i, int v){
+      owner[i] = v;
+      slot[i] = sz(buckets[v]);
+      buckets[v].push_back(i);
+    }
+
+    void removeFromBucket(int i){
+      vector<int>& b = buckets[owner[i]];
+      int last = b.back();
+      b[slot[i]] = last;
+      slot[last] = slot[i];
+      b.pop_back();
+      slot[i] = -1;
+    }
+
+    // Reconstruye todo en el tiempo t con la cadena monotona y reparte los puntos en el abanico
+    void build(double t){
+      now = t;
+      rebuilds++;
+      int n = sz(mp);
+      pq = priority_queue<Event>();
+      for(int i = 0; i < n; i++){
+        version[i]++;
+        buckets[i].clear();
+        owner[i] = -1;
+        nxt[i] = prv[i] = -1;
+      }
+
+      vector<int> ids(n);
+      for(int i = 0; i < n; i++) ids[i] = i;
+      sort(ids.begin(), ids.end(), [&](int a, int b){ return mp[a].at(now) < mp[b].at(now); });
+
+      vector<int> CH(2*n + 1);
+      int k = 0;
+      for(int i = 0; i < n; i++){
+        while(k >= 2 && !ccw(mp[CH[k-2]].at(now), mp[CH[k-1]].at(now), mp[ids[i]].at(now))) --k;
+        CH[k++] = ids[i];
+      }
+      for(int i = n-2, lim = k+1; i >= 0; i--){
+        while(k >= lim && !ccw(mp[CH[k-2]].at(now), mp[CH[k-1]].at(now), mp[ids[i]].at(now))) --k;
+        CH[k++] = ids[i];
+      }
+      hullSize = max(0, k-1);
+      degenerate = hullSize < 3;
+      if(degenerate) return;
+
+      h0 = CH[0];
+      for(int j = 0; j < hullSize; j++){
+        int v = CH[j], w = CH[(j+1) % hullSize];
+        nxt[v] = w;
+        prv[w] = v;
+        owner[v] = HULL;
+      }
+
+      // Busqueda binaria del triangulo del abanico que contiene a cada punto
+      for(int i = 0; i < n; i++){
+        if(owner[i] == HULL) continue;
+        Point q = mp[i].at(now), a = mp[h0].at(now);
+        int lo = 1, hi = hullSize-2;
+        while(lo < hi){
+          int mid = (lo + hi + 1) / 2;
+          if(cross(mp[CH[mid]].at(now) - a, q - a) >= 0) lo = mid;
+          else hi = mid - 1;
+        }
+        addToBucket(i, CH[lo]);
+      }
+
+      for(int i = 0; i < n; i++){
+        if(owner[i] == HULL) scheduleHull(i);
+        else scheduleInterior(i);
+      }
+    }
+
+    // El punto interior i salio de su triangulo T(v)
+    void leftTriangle(int i){
+      int v = owner[i], w = nxt[v];
+      int s0 = signAfter(orient(h0, v, i));
+      int s1 = signAfter(orient(v, w, i));
+      int s2 = signAfter(orient(w, h0, i));
+
+      if(s1 < 0) insertHull(i, v, w);
+      else if(s0 < 0){
+        if(prv[v] == h0) insertHull(i, h0, v);
+        else { removeFromBucket(i); addToBucket(i, prv[v]); scheduleInterior(i); }
+      }
+      else if(s2 < 0){
+        if(nxt[w] == h0) insertHull(i, w, h0);
+        else { removeFromBucket(i); addToBucket(i, w); scheduleInterior(i); }
+      }
+      else scheduleInterior(i); // Falso positivo por redondeo
+    }
+
+    // i cruza la arista a->b de la envolvente y se vuelve vertice
+    void insertHull(int i, int a, int b){
+      removeFromBucket(i);
+      owner[i] = HULL;
+      nxt[a] = i; prv[i] = a;
+      nxt[i] = b; prv[b] = i;
+      hullSize++;
+
+      if(a != h0 && b != h0){
+        // T(a) se parte en T(a) = (h0,a,i) y T(i) = (h0,i,b)
+        vector<int> old;
+        old.swap(buckets[a]);
+        for(int j : old){
+          if(signAfter(orient(h0, i, j)) >= 0) addToBucket(j, i);
+          else addToBucket(j, a);
+        }
+        for(int j : buckets[a]) scheduleInterior(j);
+        for(int j : buckets[i]) scheduleInterior(j);
+      }
+      scheduleHull(a);
+      scheduleHull(i);
+      scheduleHull(b);
+    }
+
+    // El vertice v dejo de ser convexo y pasa al interior
+    void convexityFailed(int v){
+      int a = prv[v], c = nxt[v];
+      if(v == h0 || a == h0 || c == h0 || hullSize <= 3){
+        build(now);
+        return;
+      }
+      // T(a) y T(v) se juntan en T(a) = (h0,a,c)
+      nxt[a] = c; prv[c] = a;
+      nxt[v] = prv[v] = -1;
+      hullSize--;
+      for(int j : buckets[v]) addToBucket(j, a);
+      buckets[v].clear();
+      addToBucket(v, a);
+      for(int j : buckets[a]) scheduleInterior(j);
+      scheduleHull(a);
+      scheduleHull(c);
+    }
+};
+
+#endif
@@ -0,0 +1,165 @@
+#include "ConvexHulls.hpp"
+#include "HullSummary.hpp"
+#include <bits/stdc++.h>
+#include <spawn.h>
+#include <sys/wait.h>
+using namespace std;
+
+extern char **environ;
+
+// Cada fragmento de puntos lo procesa un proceso aparte que solo regresa el resumen de su
+// envolvente. Los resumenes se combinan en un arbol: en cada nivel se lanzan en paralelo
+// procesos que unen parejas con mergeHulls, asi lo unico que viaja entre procesos son
+// unos cuantos vertices.
+
+vector<Point> readPoints(const string &filename){
+    vector<Point> points;
+    ifstream file(filename);
+    if(!file.is_open()){
+        throw runtime_error("No se encontro el archivo " + filename);
+    }
+    string line;
+    while(getline(file, line)){
+        stringstream ss(line);
+        double x, y;
+        if(!(ss >> x >> y)) continue;
+        points.push_back({x, y});
+    }
+    return points;
+}
+
+typedef vector<string> Command;
+
+// Lanza el programa con sus argumentos tal cual, sin pasar por un shell (las rutas pueden
+// tener comillas, $ o lo que sea) y espera a que termine; regresa true si salio con 0
+bool runProcess(const Command &command){
+    vector<char*> argv;
+    for(auto &a : command) argv.push_back(const_cast<char*>(a.c_str()));
+    argv.push_back(nullptr);
+    pid_t pid;
+    if(posix_spawnp(&pid, argv[0], nullptr, nullptr, argv.data(), environ) != 0) return false;
+    int status;
+    while(waitpid(pid, &status, 0) < 0){
+        if(errno != EINTR) return false;
+    }
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+string describe(const Command &command){
+    string s;
+    for(auto &a : command) s += (s.empty() ? "" : " ") + a;
+    return s;
+}
+
+// Ejecuta los comandos en paralelo, cada uno en su propio proceso, pero a lo mas uno por nucleo
+// a la vez: cada hilo de la alberca toma el siguiente comando pendiente
+void runAll(const vector<Command> &commands){
+    vector<char> ok(commands.size());
+    atomic<int> next(0);
+    int threads = min(sz(commands), max(1, (int)thread::hardware_concurrency()));
+    vector<thread> workers;
+    for(int t = 0; t < threads; t++){
+        workers.emplace_back([&]{
+            for(int i; (i = next++) < sz(commands);) ok[i] = runProcess(commands[i]);
+        });
+    }
+    for(auto &w : workers) w.join();
+    for(int i = 0; i < sz(commands); i++){
+        if(!ok[i]) throw runtime_error("Fallo el proceso: " + describe(commands[i]));
+    }
+}
+
+// Calcula la envolvente de cada fragmento y reduce los resumenes por parejas
+vector<Point> reduceShards(const string &self, const vector<string> &shards, const string &out){
+    vector<string> level;
+    vector<Command> commands;
+    for(int i = 0; i < sz(shards); i++){
+        string summary = out + ".0." + to_string(i);
+        commands.push_back({self, "shard", shards[i], summary});
+        level.push_back(summary);
+    }
+    runAll(commands);
+
+    for(int depth = 1; sz(level) > 1; depth++){
+        vector<string> next;
+        commands.clear();
+        for(int i = 0; i + 1 < sz(level); i += 2){
+            string merged = out + "." + to_string(depth) + "." + to_string(i/2);
+            commands.push_back({self, "merge", level[i], level[i+1], merged});
+            next.push_back(merged);
+        }
+        if(sz(level) % 2) next.push_back(level.back());
+        runAll(commands);
+        for(int i = 0; i + 1 < sz(level); i += 2){
+            remove(level[i].c_str());
+            remove(level[i+1].c_str());
+        }
+        level = next;
+    }
+
+    vector<Point> h = level.empty() ? vector<Point>() : readHullSummary(level[0]);
+    if(!level.empty()) remove(level[0].c_str());
+    writeHullSummary(out, h);
+    return h;
+}
+
+void usage(){
+    cout << "Uso:\n"
+         << "  reduccion shard <puntos.txt> <salida.hull>\n"
+         << "  reduccion merge <a.hull> <b.hull> <salida.hull>\n"
+         << "  reduccion reduce <salida.hull> <fragmento1.txt> [fragmento2.txt ...]\n"
+         << "  reduccion demo <fragmentos> <puntos por fragmento>\n";
+}
+
+int main(int argc, char* argv[]){
+    if(argc < 2){ usage(); return 1; }
+    string mode = argv[1], self = argv[0];
+
+    try{
+        if(mode == "shard" && argc == 4){
+            vector<Point> p = readPoints(argv[2]);
+            vector<Point> h = sz(p) < 3 ? p : monotoneChain(p);
+            writeHullSummary(argv[3], h);
+        }
+        else if(mode == "merge" && argc == 5){
+            writeHullSummary(argv[4], mergeHulls(readHullSummary(argv[2]), readHullSummary(argv[3])));
+        }
+        else if(mode == "reduce" && argc >= 4){
+            vector<string> shards(argv + 3, argv + argc);
+            print(reduceShards(self, shards, argv[2]));
+        }
+        else if(mode == "demo" && argc == 4){
+            int k = atoi(argv[2]), m = atoi(argv[3]);
+            srand(time(NULL));
+            vector<string> shards;
+            vector<Point> all;
+            for(int i = 0; i < k; i++){
+                string name = "fragmento" + to_string(i) + ".txt";
+                ofstream file(name);
+                file << setprecision(17);
+                for(Point p : randomPoints(m)){
+                    file << p.x << ' ' << p.y << '\n';
+                    all.push_back(p);
+                }
+                shards.push_back(name);
+            }
+            vector<Point> h = reduceShards(self, shards, "demo.hull");
+            for(auto &name : shards) remove(name.c_str());
+
+            vector<Point> a = sortedHullVertices(h), b = sortedHullVertices(monotoneChain(all));
+            bool same = sz(a) == sz(b);
+            for(int i = 0; same && i < sz(a); i++) same = a[i] == b[i];
+            cout << "Vertices de la envolvente: " << sz(h) << '\n';
+            cout << "Coincide con monotoneChain sobre todos los puntos: " << same << '\n';
+        }
+        else{
+            usage();
+            return 1;
+        }
+    }
+    catch(const exception &e){
+        cout << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
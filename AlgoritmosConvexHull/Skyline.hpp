@@ -0,0 +1,108 @@
+/*Puntos maximales (skyline de Pareto) en 2D*/
+#ifndef SKYLINE
+#define SKYLINE
+#include "ConvexHulls.hpp"
+#include <vector>
+#include <set>
+#include <thread>
+#include <algorithm>
+
+using namespace std;
+
+// Un punto es maximal si ningun otro tiene x y y mayores o iguales (siendo distinto).
+// Todas las funciones regresan los maximales ordenados por x creciente (y decreciente),
+// sin repetidos, usando el orden de Point de geo.hpp.
+
+// Maximales de puntos ya ordenados: se recorren de derecha a izquierda guardando la mayor y
+vector<Point> skylineFromSorted(const vector<Point> &s){
+    vector<Point> out;
+    for(int i = sz(s) - 1; i >= 0; i--){
+        if(out.empty() || s[i].y > out.back().y) out.push_back(s[i]);
+    }
+    reverse(out.begin(), out.end());
+    return out;
+}
+
+// Kirkpatrick y Seidel: se parte en la mediana de x, el punto mas alto de la mitad derecha
+// es maximal y descarta todo lo que domina en ambas mitades. Cada nivel cuesta O(n) y
+// solo hay O(log h) niveles con trabajo util, asi que es O(n log h).
+void skylineRec(vector<Point> &p, int lo, int hi, vector<Point> &out){
+    if(lo >= hi) return;
+    int mid = lo + (hi - lo) / 2;
+    nth_element(p.begin() + lo, p.begin() + mid, p.begin() + hi);
+
+    int best = mid;
+    for(int i = mid + 1; i < hi; i++){
+        if(p[i].y > p[best].y || (p[i].y == p[best].y && p[best] < p[i])) best = i;
+    }
+    Point q = p[best];
+
+    // A la izquierda solo sobreviven los mas altos que q, a la derecha los que estan despues de q
+    int l = partition(p.begin() + lo, p.begin() + mid, [&](const Point &a){ return a.y > q.y; }) - p.begin();
+    int r = partition(p.begin() + mid, p.begin() + hi, [&](const Point &a){ return q < a; }) - p.begin();
+
+    skylineRec(p, lo, l, out);
+    out.push_back(q);
+    skylineRec(p, mid, r, out);
+}
+
+vector<Point> skyline(vector<Point> p){
+    vector<Point> out;
+    skylineRec(p, 0, sz(p), out);
+    return out;
+}
+
+// Divide y venceras en paralelo: cada hilo calcula los maximales de su bloque y al final
+// se combinan los de todos, que suelen ser muy pocos
+vector<Point> skylineParallel(const vector<Point> &p, int threads = 0){
+    int n = sz(p);
+    if(threads <= 0) threads = max(1u, thread::hardware_concurrency());
+    threads = max(1, min(threads, n / 50000 + 1));
+    if(threads == 1) return skyline(p);
+
+    vector<vector<Point>> part(threads);
+    vector<thread> pool;
+    for(int t = 0; t < threads; t++){
+        pool.emplace_back([&, t]{
+            long long a = (long long)n * t / threads, b = (long long)n * (t+1) / threads;
+            part[t] = skyline(vector<Point>(p.begin() + a, p.begin() + b));
+        });
+    }
+    for(auto &th : pool) th.join();
+
+    vector<Point> cand;
+    for(auto &s : part) cand.insert(cand.end(), s.begin(), s.end());
+    sort(cand.begin(), cand.end());
+    return skylineFromSorted(cand);
+}
+
+// Skyline que se actualiza conforme llegan puntos. La escalera se guarda en un set ordenado
+// por x, donde la y va decreciendo; insertar cuesta O(log h) amortizado.
+class StreamingSkyline
+{
+  public:
+    // Regresa verdadero si p entro al skyline
+    bool insert(Point p){
+        auto it = stair.lower_bound(p);
+        // El primero con x >= p.x es el mas alto de esa parte
+        if(it != stair.end() && it->y >= p.y) return false;
+        while(it != stair.begin() && prev(it)->y <= p.y) stair.erase(prev(it));
+        stair.insert(it, p);
+        return true;
+    }
+
+    // Verdadero si algun punto del skyline domina a p (o es igual)
+    bool dominated(Point p) const{
+        auto it = stair.lower_bound(p);
+        return it != stair.end() && it->y >= p.y;
+    }
+
+    vector<Point> points() const { return vector<Point>(stair.begin(), stair.end()); }
+    int size() const { return sz(stair); }
+    bool empty() const { return stair.empty(); }
+    void clear() { stair.clear(); }
+
+  private:
+    set<Point> stair;
+};
+#endif
@@ -0,0 +1,101 @@
+/*Envolvente convexa sobre una ventana deslizante de puntos con marca de tiempo*/
+#ifndef SLIDING_WINDOW_HULL
+#define SLIDING_WINDOW_HULL
+#include "ConvexHulls.hpp"
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <limits>
+
+using namespace std;
+
+// Cola con dos pilas: los puntos nuevos entran a la pila trasera, de la que solo
+// se guarda la envolvente acumulada. Los puntos viejos salen de la pila frontal, donde
+// cada elemento guarda la envolvente de si mismo y de todos los mas nuevos que el en esa pila.
+// Cuando la frontal se vacia se pasa toda la trasera de una vez.
+// Cada punto entra y sale de cada pila una vez, asi que push/pop cuestan O(h) amortizado
+// sin importar cuantos puntos haya en la ventana, y la consulta es una mezcla O(h1+h2).
+// A cambio cada elemento de la pila frontal guarda su propia copia de la envolvente: la memoria
+// es O(W h) para una ventana de W puntos, casi O(W^2) si casi todos son vertices (un circulo).
+class SlidingWindowHull
+{
+  public:
+    // Los tiempos deben llegar en orden no decreciente, tambien contra los que ya salieron
+    void push(Point p, double t){
+      if(t < lastTime){
+        throw runtime_error("SlidingWindowHull: tiempos fuera de orden");
+      }
+      lastTime = t;
+      back.push_back({p, t});
+      backHull = mergeHulls(backHull, {p});
+      cacheValid = false;
+    }
+
+    void popFront(){
+      if(empty()) return;
+      if(front.empty()) transfer();
+      front.pop_back();
+      cacheValid = false;
+    }
+
+    // Saca todos los puntos con tiempo menor a tMin (por ejemplo ahora - W)
+    void expire(double tMin){
+      while(!empty() && oldestTime() < tMin) popFront();
+    }
+
+    // Envolvente de los puntos de la ventana, en sentido antihorario
+    const vector<Point>& hull(){
+      if(!cacheValid){
+        if(front.empty()) cache = backHull;
+        else cache = mergeHulls(front.back().hull, backHull);
+        cacheValid = true;
+      }
+      return cache;
+    }
+
+    double oldestTime() const{
+      return front.empty() ? back.front().t : front.back().t;
+    }
+
+    int size() const { return sz(front) + sz(back); }
+    bool empty() const { return front.empty() && back.empty(); }
+
+    void clear(){
+      front.clear();
+      back.clear();
+      backHull.clear();
+      cache.clear();
+      cacheValid = false;
+      lastTime = -numeric_limits<double>::infinity();
+    }
+
+  private:
+    struct Stamped{
+      Point p;
+      double t;
+    };
+    struct FrontEntry{
+      Point p;
+      double t;
+      vector<Point> hull;
+    };
+
+    vector<FrontEntry> front;   // El tope (back()) es el punto mas viejo
+    vector<Stamped> back;       // En orden de llegada
+    vector<Point> backHull;
+    vector<Point> cache;
+    bool cacheValid = false;
+    double lastTime = -numeric_limits<double>::infinity();  // Tiempo del ultimo push
+
+    void transfer(){
+      front.reserve(back.size());
+      for(int i = sz(back)-1; i >= 0; i--){
+        vector<Point> h = front.empty() ? vector<Point>{back[i].p} : mergeHulls(front.back().hull, {back[i].p});
+        front.push_back({back[i].p, back[i].t, move(h)});
+      }
+      back.clear();
+      backHull.clear();
+    }
+};
+
+#endif
@@ -1,13 +1,15 @@
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 #include "DCEL.hpp"
+#include "../renderer2d.hpp"
+#include "../scheduler.hpp"
 
 using namespace std;
 
 vector<Point> vertices;
 int diagIndex = 0;
-float timer = 0.0f;
-float delay = 0.5f;
+// Un paso (una diagonal y un vertice coloreado) cada 0.3 segundos al inicio
+StepScheduler scheduler(1 / 0.3f);
 // Para dibujar diagonales
 vector<Point> diags;
 // Para dibujar guardias y coloreo
@@ -20,6 +22,13 @@ int selectedGuard = 0;
 map<int, vector<Point>> visPolys;
 // La mera mera
 DCEL dcel;
+// Capas del renderer; solo se les agrega lo que cambia y se dibuja cada una con una llamada
+Layer2D fanLayer(GL_TRIANGLES);
+Layer2D vertexLayer(GL_POINTS, 10.0f);
+Layer2D edgeLayer(GL_LINE_STRIP, 1.0f);
+Layer2D diagLayer(GL_LINES, 2.0f);
+Layer2D colorLayer(GL_POINTS, 10.0f);
+Layer2D guardLayer(GL_POINTS, 10.0f);
 
 float getRaySegmentIntersection(Point p, Point r, Point a, Point b) {
     Point s = b-a;
@@ -139,6 +148,8 @@ void mouseCallback(GLFWwindow* window, int button, int action, int mods){
         cout << "Y: " << y << '\n';
         
         vertices.push_back(newPoint);
+        vertexLayer.add(newPoint, 1, 0, 0);
+        edgeLayer.add(newPoint, 1, 1, 1);
         
         int verticeSize = vertices.size();
         cout << verticeSize << '\n';
@@ -147,6 +158,16 @@ void mouseCallback(GLFWwindow* window, int button, int action, int mods){
 
 bool finished = false;
 
+// Vuelve a llenar las capas del poligono, cerrandolo si ya se termino
+void rebuildPolygon(){
+    vertexLayer.clear();
+    edgeLayer.clear();
+    for (auto& p : vertices) {
+        vertexLayer.add(p, 1, 0, 0);
+        edgeLayer.add(p, 1, 1, 1);
+    }
+    if (finished && !vertices.empty()) edgeLayer.add(vertices[0], 1, 1, 1);
+}
 
 // Para hacer los pasos
 void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods){
@@ -158,6 +179,7 @@ void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods
                     dcel.clear();
                     finished = false;
                 }
+                rebuildPolygon();
                 break;
         }
     }
@@ -175,18 +197,27 @@ void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods
                 diagIndex = 0;
                 colorIndex = 0;
                 selectedGuard = 0;
+                scheduler.restart();
+                fanLayer.clear();
+                vertexLayer.clear();
+                edgeLayer.clear();
+                diagLayer.clear();
+                colorLayer.clear();
+                guardLayer.clear();
                 break;
             case GLFW_KEY_C:
                 if(!finished){
                     finished = true;
                     dcel.init(vertices);
                     colorVertices.assign(vertices.size(), -1);
+                    if(!vertices.empty()) edgeLayer.add(vertices[0], 1, 1, 1);
                 }
                 break;
             case GLFW_KEY_T:
                 if(finished){
                     dcel.diags.clear();
                     dcel.triangulate();
+                    scheduler.restart();
                 }
                 break;
             case GLFW_KEY_ESCAPE:
@@ -207,8 +238,11 @@ void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods
                     }
 
                     selectedGuards = dcel.getGuardsFromDual();
+                    scheduler.restart();
 
                     cout << "Guardias necesarios: " << selectedGuards.size() << "\n";
+                    guardLayer.clear();
+                    for (int g : selectedGuards) guardLayer.add(vertices[g], 0, 1, 0);
                     for (int g : selectedGuards)
                         cout << "Guardia en vertice: " << g 
                             << " pos=(" << vertices[g].x << "," << vertices[g].y << ")\n";
@@ -219,23 +253,20 @@ void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods
                 if(!selectedGuards.empty()){
                     if(visPolys.find(selectedGuard) == visPolys.end()){
                         visPolys[selectedGuard] = visibilityPolygon(virtualGuard(selectedGuards[selectedGuard]));
+                        fanLayer.addFan(vertices[selectedGuards[selectedGuard]], visPolys[selectedGuard], 1.0f, 1.0f, 0.0f, 0.5f);
                     }
                     selectedGuard = (selectedGuard+1)%selectedGuards.size();
                 }
                 break;
+            default:
+                // Velocidad, pausa y terminar
+                scheduler.handleKey(key);
+                break;
             }
         }
 }
 
-void drawPoint(Point p, float r, float g, float b, float size = 10.0f) {
-    glPointSize(size);
-    glColor3f(r, g, b);
-    glBegin(GL_POINTS);
-    glVertex2f(p.x, p.y ); 
-    glEnd();
-}
-
-void drawColoredVertex(int v, int colorIndex) {
+void addColoredVertex(int v, int colorIndex) {
     float r,g,b;
 
     switch(colorIndex){
@@ -244,64 +275,49 @@ void drawColoredVertex(int v, int colorIndex) {
         case 2: r = 0.30f; g = 0.85f; b = 0.55f; break;   
     }
 
-    drawPoint({vertices[v].x, vertices[v].y}, r,g,b);
+    colorLayer.add(vertices[v], r, g, b);
 }
 
-void drawLine(Point a, Point b, float r, float g, float bl, float width = 3.0f) {
-    glLineWidth(width);
-    glColor3f(r, g, bl);
-    glBegin(GL_LINES);
-    glVertex2f(a.x , a.y);
-    glVertex2f(b.x, b.y);
-    glEnd();
-}
+void render() {
+    glClear(GL_COLOR_BUFFER_BIT);
 
+    fanLayer.draw();
+    vertexLayer.draw();
+    edgeLayer.draw();
+    diagLayer.draw();
 
+    if(!colorFinished) colorLayer.draw();
+    else guardLayer.draw();
+}
 
-void render() {
-    glClear(GL_COLOR_BUFFER_BIT);
+// Avanza una diagonal y un vertice coloreado; regresa falso cuando no queda nada por mostrar
+bool stepGallery() {
+    bool advanced = false;
+    if(diagIndex < dcel.diags.size()){
+        
+        auto [ak, ck] = dcel.diags[diagIndex];
 
-    if(visPolys.size() != 0){
-        for(int i = 0; i < visPolys.size(); i++){
-            glColor4f(1.0f, 1.0f, 0.0f, 0.5f); 
-            glBegin(GL_TRIANGLE_FAN);
-            glVertex2f(vertices[selectedGuards[i]].x, vertices[selectedGuards[i]].y);
-            for(auto& p : visPolys[i]){
-                glVertex2f(p.x, p.y);
-            }
-            glEnd();
-        }
-    }
-    
-    for (auto& p : vertices) drawPoint(p, 1, 0, 0);
-    if (vertices.size() > 1) {
-        glColor3f(1, 1, 1);
-        glBegin(GL_LINE_STRIP);
-        for (auto& p : vertices)
-            glVertex2f(p.x, p.y);
-            if(finished){
-                glVertex2f(vertices.begin()->x,vertices.begin()->y);
-            }
-        glEnd();
-    }
-    
-    for(int i = 0; i + 1 < diags.size(); i += 2){
-        drawLine(diags[i], diags[i+1], 0.0f, 1.0f, 0.0f, 2.0f);
-    }
+        Point A = vertices[ak];
+        Point C = vertices[ck];
 
-    if(!colorFinished){
-        for(int i = 0; i < colorVertices.size(); i++){
-            if(colorVertices[i] != -1)
-                drawColoredVertex(i, colorVertices[i]);
-        }
+        diags.push_back(A);
+        diags.push_back(C);
+        diagLayer.addLine(A, C, 0.0f, 1.0f, 0.0f);
+        
+        diagIndex++;
+        advanced = true;
     }
 
-    else{
-        for (int g : selectedGuards) {
-            drawPoint({vertices[g].x, vertices[g].y}, 0, 1, 0);
-        }
+    if(colorIndex < dcel.colorOrder.size()){
+        int v = dcel.colorOrder[colorIndex];   
+        int c = dcel.colors[v];                
+        colorVertices[v] = c;                  
+        addColoredVertex(v, c);
+        colorIndex++;
+        colorFinished = (colorIndex == dcel.colorOrder.size());
+        advanced = true;
     }
-    
+    return advanced;
 }
 
 // ---------------------------- IMPORTANTISISISISIMO ---------------------------- //
@@ -333,48 +349,23 @@ int main(void)
     glfwSetMouseButtonCallback(window, mouseCallback);
     glfwSetKeyCallback(window, keyCallback);
 
-    float timePerStep = 0.3f;
-    
-    float lastTime = glfwGetTime();
-
     while (!glfwWindowShouldClose(window))
     {
         glClearColor(0.15f, 0.15f, 0.15f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); 
-        float now = glfwGetTime();
-
-        if (now - lastTime > timePerStep) {
-            lastTime = now;
-            if(diagIndex < dcel.diags.size()){
-                
-                auto [ak, ck] = dcel.diags[diagIndex];
-
-                Point A = vertices[ak];
-                Point C = vertices[ck];
-
-                diags.push_back(A);
-                diags.push_back(C);
-                
-                diagIndex++;
-            }
-
-            if(colorIndex < dcel.colorOrder.size()){
-                int v = dcel.colorOrder[colorIndex];   
-                int c = dcel.colors[v];                
-                colorVertices[v] = c;                  
-                colorIndex++;
-                colorFinished = (colorIndex == dcel.colorOrder.size());
-            }
-
-        }
-
+        scheduler.advance(stepGallery);
 
         render();
         glfwSwapBuffers(window);
         glfwPollEvents();
     }
     
-
+    fanLayer.release();
+    vertexLayer.release();
+    edgeLayer.release();
+    diagLayer.release();
+    colorLayer.release();
+    guardLayer.release();
     glfwTerminate();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,241 @@
+#define HULL_COUNTERS
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "../geo.hpp"
+#include "../AlgoritmosConvexHull/HullSteps.hpp"
+#include "../scheduler.hpp"
+#include "HullView.hpp"
+
+using namespace std;
+
+// Modo carrera: los algoritmos corren a la vez, cada uno en su hilo, sobre los mismos puntos
+// y sin limite de pasos por segundo, y cada uno se dibuja en su propio panel. Arriba de cada
+// panel hay tres barras, relativas al maximo entre todos: pruebas de orientacion (amarillo),
+// pops (magenta) y tiempo real desde la salida (cian). Los numeros van en el titulo de la
+// ventana.
+
+vector<Point> randomPoints(int n) {
+    vector<Point>points;
+    for (int i = 0; i < n; i++) {
+        float xrand = -0.9 + 1.5 * (float)rand() / (RAND_MAX + 1.0);
+        float yrand = -0.9 + 1.5 * (float)rand() / (RAND_MAX + 1.0);
+
+        points.push_back({ xrand, yrand });
+    }
+
+    return points;
+}
+
+// La cadena monotona necesita los puntos ordenados; se ordenan dentro del primer paso
+// para que el ordenamiento cuente en su tiempo
+Generator<HullStep> sortedMonotoneChainSteps(vector<Point>& p, vector<Point>& CH) {
+    sort(p.begin(), p.end());
+    Generator<HullStep> steps = monotoneChainSteps(p, CH, true);
+    while (steps.next()) co_yield steps.value();
+}
+
+using Clock = chrono::steady_clock;
+
+// Contadores de cada algoritmo
+struct RaceStats {
+    long long tests = 0, pops = 0, steps = 0;
+    double seconds = 0;              // Tiempo real desde la salida
+    int hullSize = 0;
+    bool finished = false;
+};
+
+// Lo que cada hilo publica para la ventana
+struct RaceFrame {
+    HullFrame hull;
+    RaceStats stats;
+};
+
+struct Racer {
+    string name;
+    Generator<HullStep> (*make)(vector<Point>&, vector<Point>&);
+    vector<Point> points, hull;
+    Generator<HullStep> steps;
+    HullFrame live;                  // Envolvente en el hilo del algoritmo, armada con los eventos
+    TripleBuffer<RaceFrame> buffer;
+    thread worker;
+    atomic<bool> stopping{false};
+    HullView view;
+    RaceStats last;                  // Ultimos contadores recibidos en la ventana
+    Layer2D barLayer{GL_TRIANGLES};
+
+    Racer(string name, Generator<HullStep> (*make)(vector<Point>&, vector<Point>&), bool showBest)
+        : name(name), make(make), view(showBest) {}
+
+    // Corre todos los pasos seguidos desde el instante go, el mismo para todos. Cada ~5 ms
+    // publica lo que hay para la ventana; el reloj se consulta cada 64 pasos.
+    void start(const vector<Point>& input, Clock::time_point go) {
+        points = input;
+        view.setPoints(points);
+        steps = make(points, hull);
+        worker = thread([this, go] {
+            this_thread::sleep_until(go);
+            Clock::time_point lastPublish = go;
+            long long k = 0;
+            bool done = false;
+            while (!done && !stopping) {
+                done = !steps.next();
+                if (!done) {
+                    live.apply(steps.value());
+                    done = live.current.kind == DONE;
+                    k++;
+                }
+                if (!done && (k & 63) != 0) continue;
+                Clock::time_point now = Clock::now();
+                if (!done && now - lastPublish < chrono::milliseconds(5)) continue;
+                lastPublish = now;
+                publish(k, chrono::duration<double>(now - go).count(), done);
+            }
+        });
+    }
+
+    // Corre en el hilo del algoritmo, asi que hullCounters es el suyo
+    void publish(long long k, double seconds, bool done) {
+        RaceFrame& f = buffer.back();
+        f.hull.assign(live);
+        f.hull.finished = done;
+        f.stats.tests = hullCounters.orientationTests;
+        f.stats.pops = hullCounters.pops;
+        f.stats.steps = k;
+        f.stats.seconds = seconds;
+        f.stats.hullSize = sz(hull);
+        f.stats.finished = done;
+        buffer.publish();
+    }
+
+    void stop() {
+        stopping = true;
+        if (worker.joinable()) worker.join();
+    }
+};
+
+const int RACERS = 3;
+Racer* racers[RACERS];
+
+void keyCallback(GLFWwindow* window, int key, int, int action, int) {
+    if (action != GLFW_PRESS) return;
+    if (key == GLFW_KEY_ESCAPE) glfwSetWindowShouldClose(window, true);
+}
+
+// Barra horizontal de largo proporcional a value / maxValue
+void addBar(Layer2D& layer, float y, double value, double maxValue, float r, float g, float b) {
+    float len = maxValue > 0 ? 1.8f * value / maxValue : 0;
+    Point p0(-0.9, y), p1(-0.9 + len, y), p2(-0.9 + len, y + 0.05), p3(-0.9, y + 0.05);
+    layer.addFan(p0, {p1, p2, p3}, r, g, b);
+}
+
+int main(int argc, char* argv[]) {
+    srand(time(NULL));
+    int n = argc > 1 ? atoi(argv[1]) : 2000;
+    vector<Point> points = randomPoints(n);
+
+    // Para agregar otro algoritmo basta con otro Racer con su generador de pasos
+    Racer jarvis("Jarvis", [](vector<Point>& p, vector<Point>& CH) { return jarvisMarchSteps(p, CH, true); }, true);
+    Racer graham("Graham", [](vector<Point>& p, vector<Point>& CH) { return grahamScanSteps(p, CH, true); }, false);
+    Racer monotone("Monotone", sortedMonotoneChainSteps, false);
+    racers[0] = &jarvis;
+    racers[1] = &graham;
+    racers[2] = &monotone;
+
+    if (!glfwInit()) return -1;
+    // Maximizar ventana
+    glfwWindowHint(GLFW_MAXIMIZED, GLFW_TRUE);
+    GLFWwindow* window = glfwCreateWindow(1920, 1080, "Carrera", NULL, NULL);
+    if (!window) { glfwTerminate(); return -1; }
+
+    glfwMakeContextCurrent(window);
+    if (glewInit() != GLEW_OK) {
+        cout << "Error init GLEW\n"; return -1;
+    }
+    glfwSetKeyCallback(window, keyCallback);
+
+    Layer2D border(GL_LINES, 2.0f);
+    border.addLine(Point(-0.999, -1), Point(-0.999, 1), 0.5, 0.5, 0.5);
+
+    // Todos arrancan al mismo tiempo, cuando ya estan creados los hilos
+    Clock::time_point go = Clock::now() + chrono::milliseconds(50);
+    for (Racer* r : racers) r->start(points, go);
+
+    bool reported = false;
+    float lastTitle = 0;
+    // Mostrar la ventana hasta que se cierre
+    while (!glfwWindowShouldClose(window)) {
+        bool allDone = true;
+        double maxTests = 0, maxPops = 0, maxTime = 0;
+        for (Racer* r : racers) {
+            if (const RaceFrame* f = r->buffer.read()) {
+                r->last = f->stats;
+                r->view.show(f->hull);
+            }
+            allDone = allDone && r->last.finished;
+            maxTests = max(maxTests, (double)r->last.tests);
+            maxPops = max(maxPops, (double)r->last.pops);
+            maxTime = max(maxTime, r->last.seconds);
+        }
+
+        int width, height;
+        glfwGetFramebufferSize(window, &width, &height);
+        glClear(GL_COLOR_BUFFER_BIT);
+        for (int i = 0; i < RACERS; i++) {
+            Racer* r = racers[i];
+            glViewport(i * width / RACERS, 0, width / RACERS, height);
+            r->view.draw();
+
+            r->barLayer.clear();
+            addBar(r->barLayer, 0.90, r->last.tests, maxTests, 1, 1, 0);
+            addBar(r->barLayer, 0.82, r->last.pops, maxPops, 1, 0, 1);
+            addBar(r->barLayer, 0.74, r->last.seconds, maxTime, 0, 1, 1);
+            r->barLayer.draw();
+            if (i > 0) border.draw();
+        }
+        glViewport(0, 0, width, height);
+
+        float now = glfwGetTime();
+        if (now - lastTitle > 0.2f) {
+            lastTitle = now;
+            string title = "Carrera";
+            for (Racer* r : racers) {
+                char buf[160];
+                snprintf(buf, sizeof(buf), "  |  %s%s: %.1f ms, %lld orient, %lld pops", r->name.c_str(),
+                         r->last.finished ? " (fin)" : "", r->last.seconds * 1000, r->last.tests, r->last.pops);
+                title += buf;
+            }
+            glfwSetWindowTitle(window, title.c_str());
+        }
+
+        if (allDone && !reported) {
+            reported = true;
+            cout << "n = " << n << '\n';
+            for (Racer* r : racers) {
+                cout << r->name << ": " << r->last.seconds * 1000 << " ms, " << r->last.tests << " pruebas de orientacion, "
+                     << r->last.pops << " pops, " << r->last.steps << " pasos, envolvente de " << r->last.hullSize << '\n';
+            }
+        }
+
+        glfwSwapBuffers(window);
+        glfwPollEvents();
+    }
+
+    for (Racer* r : racers) {
+        r->stop();
+        r->view.release();
+        r->barLayer.release();
+    }
+    border.release();
+    glfwTerminate();
+    return 0;
+}
@@ -2,18 +2,22 @@
 #include <GLFW/glfw3.h>
 #include <iostream>
 #include <vector>
+#include <string>
 #include <cstdlib>
 #include <ctime>
 #include <algorithm>
 #include "../geo.hpp"
+#include "../AlgoritmosConvexHull/HullSteps.hpp"
+#include "../scheduler.hpp"
+#include "HullView.hpp"
 
 using namespace std;
 
-vector<point> randomPoints(int n) {
-    vector<point>points;
+vector<Point> randomPoints(int n) {
+    vector<Point>points;
     for (int i = 0; i < n; i++) {
-        float xrand = -0.9 + 1.5 * (float)rand() / (RAND_MAX + 1);
-        float yrand = -0.9 + 1.5 * (float)rand() / (RAND_MAX + 1);
+        float xrand = -0.9 + 1.5 * (float)rand() / (RAND_MAX + 1.0);
+        float yrand = -0.9 + 1.5 * (float)rand() / (RAND_MAX + 1.0);
 
         points.push_back({ xrand, yrand });
     }
@@ -21,135 +25,74 @@ vector<point> randomPoints(int n) {
     return points;
 }
 
-void drawPoint(point p, float r, float g, float b, float size = 5.0f) {
-    glPointSize(size);
-    glColor3f(r, g, b);
-    glBegin(GL_POINTS);
-    glVertex2f(p.x, p.y);
-    glEnd();
+vector<Point> points;
+vector<Point> hull;          // La escribe grahamScanSteps conforme avanza
+
+Generator<HullStep> steps;   // Pasos del algoritmo real de HullSteps.hpp
+HullStep current{DONE, {}, {}, {}};      // Ultimo evento, para dibujar la comparacion
+
+// Modificar para ajustar los pasos por segundo iniciales
+StepScheduler scheduler(20);
+StepWorker<HullFrame> worker;
+bool threaded = false;       // Con -t los pasos corren en otro hilo
+HullFrame live;              // Envolvente en el hilo de los pasos, armada con los eventos
+HullView view;
+
+// Un paso del algoritmo; regresa falso cuando ya termino
+bool stepGrahamScan() {
+    if (!steps.next()) return false;
+    current = steps.value();
+    if (threaded) live.apply(current);
+    else view.apply(current);
+    return current.kind != DONE;
 }
 
-void drawLine(point p, point q, float r, float g, float b, float width = 1.0f) {
-    glLineWidth(width);
-    glColor3f(r, g, b);
-    glBegin(GL_LINES);
-    glVertex2f(p.x, p.y);
-    glVertex2f(q.x, q.y);
-    glEnd();
+void keyCallback(GLFWwindow* window, int key, int, int action, int) {
+    if (action != GLFW_PRESS) return;
+    if (key == GLFW_KEY_ESCAPE) glfwSetWindowShouldClose(window, true);
+    else scheduler.handleKey(key);
 }
 
-vector<point> points;
-vector<point> hull;
-
-int pivotIdx = -1;      // Punto actual del hull
-bool finished = false;
-bool popping = false;
-
-float lastTime = 0;
-
-void stepGrahamScan(vector<point>& p) {
-    int n = (int)p.size();
-    if (finished || n <= 3) return; // n <=3 representa una linea o triangulo
-
-    if (hull.empty()) {
-        int l = 0;
-        
-        for (int i = 1; i < n; i++) {
-            if (p[i] < p[l]) l = i;
-        }
-
-        pivotIdx = l;
-		swap(p[0], p[pivotIdx]);
-
-        sort(++p.begin(), p.end(), [&](point a, point b) {
-            if (ccw(p[0], a, b)) return true;
-            if (ccw(p[0], b, a)) return false;
-            return dist(p[0], a) < dist(p[0], b);
-            });
-
-		hull.push_back(p[0]);
-		hull.push_back(p[1]);
-
-        pivotIdx = 2;
-        return;
-    }
-
-    if (pivotIdx < n) {
-        point next = p[pivotIdx];
-        if (!popping) {
-			hull.push_back(next);
-            popping = true;
-        }
-        else{
-            if(hull.size() > 2 && !ccw(hull[hull.size() - 3], hull[hull.size() - 2], next)) {
-                hull.erase(hull.end()-2); // Para nada optimo, pero la visualizacion se ve bonita.
-			}
-            else {
-                pivotIdx++;
-                popping = false;
-            }
-		}
-    }
-    else {
-        finished = true;
-    }
-}
-
-void render() {
-    glClear(GL_COLOR_BUFFER_BIT);
-
-    for (auto& p : points) drawPoint(p, 1, 0, 0);
-
-    if (hull.size() > 1) {
-        glColor3f(1, 1, 1);
-        glBegin(GL_LINE_STRIP);
-        for (auto& p : hull)
-            glVertex2f(p.x, p.y);
-        glEnd();
-    }
-
-    if (finished) {
-        drawLine(hull.back(), hull.front(), 1, 1, 1, 2.0f);
-    }
-
-    for (auto& p : hull) drawPoint(p, 1, 1, 1, 8.0f);
-}
-
-int main() {
+int main(int argc, char* argv[]) {
     srand(time(NULL));
     // Generar puntos aleatorios
-    points = randomPoints(100);
+    points = randomPoints(argc > 1 ? atoi(argv[1]) : 100);
+    threaded = argc > 2 && string(argv[2]) == "-t";
+    view.setPoints(points);
+    steps = grahamScanSteps(points, hull, true);
 
     if (!glfwInit()) return -1;
     // Maximizar ventana
     glfwWindowHint(GLFW_MAXIMIZED, GLFW_TRUE);
     GLFWwindow* window = glfwCreateWindow(1920, 1080, "Graham Scan", NULL, NULL);
     if (!window) { glfwTerminate(); return -1; }
-    // Crear ventana
+
     glfwMakeContextCurrent(window);
     if (glewInit() != GLEW_OK) {
         cout << "Error init GLEW\n"; return -1;
     }
-    // Modificar esta variable para ajustar el tiempo entre pasos
-    float timePerStep = 0.05;
-    
-    lastTime = glfwGetTime();
+    glfwSetKeyCallback(window, keyCallback);
+
+    if (threaded) {
+        worker.start(scheduler, stepGrahamScan, [](HullFrame& f) {
+            f.assign(live);
+            f.finished = scheduler.done();
+        });
+    }
 
     // Mostrar la ventana hasta que se cierre
     while (!glfwWindowShouldClose(window)) {
+        if (!threaded) scheduler.advance(stepGrahamScan);
+        else if (const HullFrame* f = worker.latest()) view.show(*f);
 
-        float now = glfwGetTime();
-
-        if (now - lastTime > timePerStep) {
-            stepGrahamScan(points);
-            lastTime = now;
-        }
-
-        render();
+        glClear(GL_COLOR_BUFFER_BIT);
+        view.draw();
         glfwSwapBuffers(window);
         glfwPollEvents();
     }
 
+    worker.stop();
+    view.release();
     glfwTerminate();
     return 0;
 }
@@ -0,0 +1,143 @@
+/*Vista compartida de las animaciones de envolvente convexa*/
+#ifndef HULL_VIEW
+#define HULL_VIEW
+#include "../geo.hpp"
+#include "../AlgoritmosConvexHull/HullSteps.hpp"
+#include "../renderer2d.hpp"
+#include <vector>
+
+using namespace std;
+
+// Lo que se necesita para dibujar una animacion; es lo que pasa por el TripleBuffer
+// cuando los pasos corren en otro hilo. Cada vertice lleva en ids el numero del PUSH que lo
+// agrego: como la envolvente es una pila, si dos copias tienen el mismo id en la posicion k
+// tambien coinciden en todo lo de abajo, y basta copiar (y subir) lo que va despues.
+struct HullFrame{
+    vector<Point> hull;
+    vector<long long> ids;
+    long long pushes = 0;
+    HullStep current{DONE, {}, {}, {}};
+    bool finished = false;
+
+    // Sigue los eventos del algoritmo, en su hilo
+    void apply(const HullStep &s){
+        current = s;
+        if (s.kind == PUSH) {
+            hull.push_back(s.a);
+            ids.push_back(++pushes);
+        }
+        else if (s.kind == POP) {
+            hull.pop_back();
+            ids.pop_back();
+        }
+    }
+
+    // Cuantos vertices del principio tiene en comun con o, en O(log h)
+    int common(const HullFrame &o) const {
+        int lo = 0, hi = min(sz(ids), sz(o.ids));
+        while (lo < hi) {
+            int m = (lo + hi + 1) / 2;
+            if (ids[m-1] == o.ids[m-1]) lo = m;
+            else hi = m - 1;
+        }
+        return lo;
+    }
+
+    // Se vuelve una copia de o copiando solo lo que cambio
+    void assign(const HullFrame &o){
+        int k = common(o);
+        hull.resize(k);
+        ids.resize(k);
+        hull.insert(hull.end(), o.hull.begin() + k, o.hull.end());
+        ids.insert(ids.end(), o.ids.begin() + k, o.ids.end());
+        pushes = o.pushes;
+        current = o.current;
+        finished = o.finished;
+    }
+};
+
+// Capas de una animacion: puntos, aristas y vertices de la envolvente, y la comparacion
+// actual. showBest dibuja tambien el mejor candidato (a -> c), como en Jarvis.
+class HullView{
+    private:
+    bool showBest;
+    HullStep current{DONE, {}, {}, {}};
+    bool finished = false;
+    HullFrame shown;        // Lo que ya esta en las capas, en modo con hilo
+    Layer2D pointLayer{GL_POINTS, 5.0f};
+    Layer2D hullLayer{GL_LINE_STRIP, 1.0f};
+    Layer2D hullPointLayer{GL_POINTS, 8.0f};
+    Layer2D testLayer{GL_LINES, 1.0f};
+    Layer2D bestLayer{GL_LINES, 2.0f};
+
+    public:
+    HullView(bool showBest = false) : showBest(showBest) {}
+
+    void setPoints(const vector<Point> &points){
+        pointLayer.clear();
+        for (auto& p : points) pointLayer.add(p, 1, 0, 0);
+    }
+
+    // Aplica un evento: solo se manda a las capas lo que cambio
+    void apply(const HullStep &s){
+        current = s;
+        if (s.kind == PUSH) {
+            hullLayer.add(s.a, 1, 1, 1);
+            hullPointLayer.add(s.a, 1, 1, 1);
+        }
+        else if (s.kind == POP) {
+            hullLayer.truncate(hullLayer.count() - 1);
+            hullPointLayer.truncate(hullPointLayer.count() - 1);
+        }
+        else if (s.kind == DONE && !finished) {
+            // Cierra la envolvente; DONE trae el primer vertice
+            finished = true;
+            hullLayer.add(s.a, 1, 1, 1);
+        }
+    }
+
+    // Muestra la envolvente que llega de otro hilo: se quitan los vertices que ya no estan y
+    // se agregan los nuevos, asi cada cuadro cuesta lo que cambio y no toda la envolvente
+    void show(const HullFrame &f){
+        current = f.current;
+        finished = f.finished;
+        int k = shown.common(f);
+        // Tambien quita el vertice que cerraba la envolvente, si estaba
+        hullLayer.truncate(k);
+        hullPointLayer.truncate(k);
+        for (int i = k; i < sz(f.hull); i++) {
+            hullLayer.add(f.hull[i], 1, 1, 1);
+            hullPointLayer.add(f.hull[i], 1, 1, 1);
+        }
+        if (finished && !f.hull.empty()) hullLayer.add(f.hull[0], 1, 1, 1);
+        shown.assign(f);
+    }
+
+    void draw(){
+        testLayer.clear();
+        bestLayer.clear();
+        if (!finished && current.kind == COMPARE) {
+            if (showBest) {
+                testLayer.addLine(current.a, current.b, 1, 1, 0.5);
+                bestLayer.addLine(current.a, current.c, 0, 1, 0);
+            }
+            else testLayer.addLine(current.c, current.b, 1, 1, 0.5);
+        }
+
+        pointLayer.draw();
+        hullLayer.draw();
+        testLayer.draw();
+        bestLayer.draw();
+        hullPointLayer.draw();
+    }
+
+    // Antes de glfwTerminate
+    void release(){
+        pointLayer.release();
+        hullLayer.release();
+        hullPointLayer.release();
+        testLayer.release();
+        bestLayer.release();
+    }
+};
+#endif
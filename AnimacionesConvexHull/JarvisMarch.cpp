@@ -2,17 +2,22 @@
 #include <GLFW/glfw3.h>
 #include <iostream>
 #include <vector>
+#include <string>
 #include <cstdlib>
 #include <ctime>
+#include <algorithm>
 #include "../geo.hpp"
+#include "../AlgoritmosConvexHull/HullSteps.hpp"
+#include "../scheduler.hpp"
+#include "HullView.hpp"
 
 using namespace std;
 
-vector<point> randomPoints(int n) {
-    vector<point>points;
+vector<Point> randomPoints(int n) {
+    vector<Point>points;
     for (int i = 0; i < n; i++) {
-        float xrand = -0.9 + 1.5 * (float)rand() / (RAND_MAX + 1);
-        float yrand = -0.9 + 1.5 * (float)rand() / (RAND_MAX + 1);
+        float xrand = -0.9 + 1.5 * (float)rand() / (RAND_MAX + 1.0);
+        float yrand = -0.9 + 1.5 * (float)rand() / (RAND_MAX + 1.0);
 
         points.push_back({ xrand, yrand });
     }
@@ -20,103 +25,41 @@ vector<point> randomPoints(int n) {
     return points;
 }
 
-vector<point> points;
-vector<point> hull;
-
-int pivot = -1;      // Punto actual del hull
-int bestIdx = -1;    // Mejor candidato actual
-int testIdx = -1;    // Índice en barrido
-bool finished = false;
-
-float lastTime = 0;
-
-void drawPoint(point p, float r, float g, float b, float size = 5.0f) {
-    glPointSize(size);
-    glColor3f(r, g, b);
-    glBegin(GL_POINTS);
-    glVertex2f(p.x, p.y ); 
-    glEnd();
+vector<Point> points;
+vector<Point> hull;          // La escribe jarvisMarchSteps conforme avanza
+
+Generator<HullStep> steps;   // Pasos del algoritmo real de HullSteps.hpp
+HullStep current{DONE, {}, {}, {}};      // Ultimo evento: pivote, punto en prueba y mejor candidato
+
+// Modificar para ajustar los pasos por segundo iniciales
+StepScheduler scheduler(20);
+StepWorker<HullFrame> worker;
+bool threaded = false;       // Con -t los pasos corren en otro hilo
+HullFrame live;              // Envolvente en el hilo de los pasos, armada con los eventos
+HullView view(true);
+
+// Un paso del algoritmo; regresa falso cuando ya termino
+bool stepJarvisMarch() {
+    if (!steps.next()) return false;
+    current = steps.value();
+    if (threaded) live.apply(current);
+    else view.apply(current);
+    return current.kind != DONE;
 }
 
-void drawLine(point a, point b, float r, float g, float bl, float width = 1.0f) {
-    glLineWidth(width);
-    glColor3f(r, g, bl);
-    glBegin(GL_LINES);
-    glVertex2f(a.x , a.y);
-    glVertex2f(b.x, b.y);
-    glEnd();
+void keyCallback(GLFWwindow* window, int key, int, int action, int) {
+    if (action != GLFW_PRESS) return;
+    if (key == GLFW_KEY_ESCAPE) glfwSetWindowShouldClose(window, true);
+    else scheduler.handleKey(key);
 }
 
-void stepJarvisMarch(vector<point>& p) {
-    int n = (int)p.size();
-    if (finished || n <= 3) return; // n <=3 representa una linea o triangulo
-
-    if (hull.empty()) {
-        int l = 0;
-
-        for (int i = 1; i < n; i++) {
-            if (p[i] < p[l]) l = i;
-        }
-
-        pivot = l;
-        hull.push_back(p[pivot]);
-
-        bestIdx = (pivot + 1) % n;
-        testIdx = 0;
-        return;
-    }
-
-    if (testIdx != pivot) {
-        if (ccw(p[pivot], p[testIdx], p[bestIdx])) {
-            bestIdx = testIdx; 
-        }
-    }
-
-    testIdx++;
-
-    if (testIdx >= n) {
-        if (p[bestIdx] == hull[0]) {
-            finished = true;
-        }
-        else {
-            hull.push_back(p[bestIdx]);
-            pivot = bestIdx;
-
-            bestIdx = (pivot + 1) % n;
-            testIdx = testIdx % n;
-        }
-    }
-}
-
-void render() {
-    glClear(GL_COLOR_BUFFER_BIT);
-
-    for (auto& p : points) drawPoint(p, 1, 0, 0);
-
-    if (hull.size() > 1) {
-        glColor3f(1, 1, 1);
-        glBegin(GL_LINE_STRIP);
-        for (auto& p : hull)
-            glVertex2f(p.x, p.y);
-        glEnd();
-    }
-
-    if (!finished && pivot != -1 && testIdx < points.size()) {
-        drawLine(points[pivot], points[testIdx], 1, 1, 0.5);
-        drawLine(points[pivot], points[bestIdx], 0, 1, 0, 2.0f); 
-    }
-
-    if (finished) {
-		drawLine(hull.back(), hull.front(), 1, 1, 1, 2.0f); 
-    }
-
-    for (auto& p : hull) drawPoint(p, 1, 1, 1, 8.0f);
-}
-
-int main() {
+int main(int argc, char* argv[]) {
     srand(time(NULL));
     // Generar puntos aleatorios
-	points = randomPoints(100);
+    points = randomPoints(argc > 1 ? atoi(argv[1]) : 100);
+    threaded = argc > 2 && string(argv[2]) == "-t";
+    view.setPoints(points);
+    steps = jarvisMarchSteps(points, hull, true);
 
     if (!glfwInit()) return -1;
     // Maximizar ventana
@@ -128,26 +71,28 @@ int main() {
     if (glewInit() != GLEW_OK) {
         cout << "Error init GLEW\n"; return -1;
     }
+    glfwSetKeyCallback(window, keyCallback);
 
-    // Modificar esta variable para ajustar el tiempo entre pasos
-    float timePerStep = 0.05;
+    if (threaded) {
+        worker.start(scheduler, stepJarvisMarch, [](HullFrame& f) {
+            f.assign(live);
+            f.finished = scheduler.done();
+        });
+    }
 
-    lastTime = glfwGetTime();
     // Mostrar la ventana hasta que se cierre
     while (!glfwWindowShouldClose(window)) {
+        if (!threaded) scheduler.advance(stepJarvisMarch);
+        else if (const HullFrame* f = worker.latest()) view.show(*f);
 
-        float now = glfwGetTime();
-
-        if (now - lastTime > timePerStep) { 
-            stepJarvisMarch(points);
-            lastTime = now;
-        }
-
-        render();
+        glClear(GL_COLOR_BUFFER_BIT);
+        view.draw();
         glfwSwapBuffers(window);
         glfwPollEvents();
     }
 
+    worker.stop();
+    view.release();
     glfwTerminate();
     return 0;
 }
@@ -0,0 +1,184 @@
+#include "delaunay.hpp"
+#include <bits/stdc++.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+using namespace std;
+
+// Mide el tiempo en milisegundos de una función
+template<class F>
+double timeMs(F&& f){
+    auto start = chrono::steady_clock::now();
+    f();
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+// Cuenta los fallos de caché del proceso con perf_event_open. Si el sistema no lo permite
+// (otro sistema operativo, contenedor, perf_event_paranoid alto) count() regresa -1.
+class CacheMisses{
+    int fd = -1;
+    public:
+    CacheMisses(){
+#ifdef __linux__
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+    }
+    ~CacheMisses(){
+#ifdef __linux__
+        if(fd >= 0) close(fd);
+#endif
+    }
+    void start(){
+#ifdef __linux__
+        if(fd < 0) return;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+    long long count(){
+#ifdef __linux__
+        long long c;
+        if(fd < 0) return -1;
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        if(read(fd, &c, sizeof(c)) != sizeof(c)) return -1;
+        return c;
+#else
+        return -1;
+#endif
+    }
+};
+
+vector<Point3> randomPoints(int n){
+    vector<Point3> p(n);
+    for(auto& q : p) q = Point3(-1 + 2.0*rand()/RAND_MAX, 0, -1 + 2.0*rand()/RAND_MAX);
+    return p;
+}
+
+// Orden radial (sweep-hull) contra BRIO con caminata, mismos puntos
+void benchOrder(int n){
+    vector<Point3> p = randomPoints(n);
+    CacheMisses misses;
+    size_t t1 = 0, t2 = 0;
+
+    misses.start();
+    double tRadial = timeMs([&]{ Delaunay d(p, RADIAL); t1 = d.triangles.size() / 3; });
+    long long mRadial = misses.count();
+
+    misses.start();
+    double tBrio = timeMs([&]{ Delaunay d(p, BRIO); t2 = d.triangles.size() / 3; });
+    long long mBrio = misses.count();
+
+    auto show = [](long long m){ return m < 0 ? string("n/d") : to_string(m); };
+    cout << "  n = " << n << ": radial " << tRadial << " ms (" << show(mRadial) << " fallos de cache), BRIO "
+         << tBrio << " ms (" << show(mBrio) << " fallos de cache)"
+         << (t1 == t2 ? "" : "  (el numero de triangulos no coincide!)") << '\n';
+}
+
+// Predicados sobre los Point3 contra la copia compacta de (x, z), mismos puntos y mismo orden
+void benchLayout(int n, InsertionOrder order){
+    vector<Point3> p = randomPoints(n);
+    vector<unsigned int> t1, t2;
+    double tPoints = timeMs([&]{ Delaunay d(p, order, POINTS); t1 = move(d.triangles); });
+    double tCompact = timeMs([&]{ Delaunay d(p, order, COMPACT); t2 = move(d.triangles); });
+    cout << "  n = " << n << ", " << (order == BRIO ? "BRIO" : "radial") << ": Point3 " << tPoints
+         << " ms, compacto " << tCompact << " ms" << (t1 == t2 ? "" : "  (las triangulaciones no coinciden!)") << '\n';
+}
+
+// Triángulos como (menor índice primero) y ordenados, para comparar triangulaciones
+vector<array<unsigned int, 3>> canonical(const vector<unsigned int>& t){
+    vector<array<unsigned int, 3>> c;
+    for(size_t e = 0; e < t.size(); e += 3){
+        array<unsigned int, 3> a = {t[e], t[e + 1], t[e + 2]};
+        rotate(a.begin(), min_element(a.begin(), a.end()), a.end());
+        c.push_back(a);
+    }
+    sort(c.begin(), c.end());
+    return c;
+}
+
+// Rejilla en desorden: todos sus cuadrados son cocirculares, así que cada diagonal es un empate
+// de InCircle. Con los empates rotos por índice los dos órdenes dan la misma triangulación.
+void benchGrid(int side){
+    vector<Point3> p;
+    for(int i = 0; i < side; i++)
+        for(int j = 0; j < side; j++) p.push_back(Point3(i, 0, j));
+    shuffle(p.begin(), p.end(), mt19937(side));
+    vector<unsigned int> t1, t2;
+    double tRadial = timeMs([&]{ Delaunay d(p, RADIAL); t1 = move(d.triangles); });
+    double tBrio = timeMs([&]{ Delaunay d(p, BRIO); t2 = move(d.triangles); });
+    cout << "  " << side << " x " << side << ": radial " << tRadial << " ms, BRIO " << tBrio << " ms"
+         << (canonical(t1) == canonical(t2) ? "" : "  (las triangulaciones no coinciden!)") << '\n';
+}
+
+// Puntos uniformes en [-scale, scale]: los predicados no dependen de la escala, así que con
+// coordenadas diminutas o enormes los dos órdenes tienen que usar todos los puntos y coincidir
+void benchScale(int n, double scale){
+    vector<Point3> p = randomPoints(n);
+    for(auto& q : p){
+        q.x *= scale;
+        q.z *= scale;
+    }
+    vector<unsigned int> t1, t2;
+    double tRadial = timeMs([&]{ Delaunay d(p, RADIAL); t1 = move(d.triangles); });
+    double tBrio = timeMs([&]{ Delaunay d(p, BRIO); t2 = move(d.triangles); });
+    size_t used = unordered_set<unsigned int>(t1.begin(), t1.end()).size();
+    cout << "  n = " << n << ", escala " << scale << ": radial " << tRadial << " ms, BRIO " << tBrio << " ms"
+         << (used == p.size() ? "" : "  (faltan puntos!)")
+         << (canonical(t1) == canonical(t2) ? "" : "  (las triangulaciones no coinciden!)") << '\n';
+}
+
+#ifdef DELAUNAY_STATS
+// Contadores internos en JSON, con puntos uniformes y con todos los puntos sobre un círculo
+// (la envolvente tiene todos los puntos)
+void benchStats(int n){
+    vector<Point3> p = randomPoints(n), c(n);
+    for(int i = 0; i < n; i++){
+        double a = 2 * M_PI * rand() / RAND_MAX;
+        c[i] = Point3(cos(a), 0, sin(a));
+    }
+    Delaunay d(p), b(p, BRIO), r(c);
+    cout << "  n = " << n << ", uniformes, radial: " << d.stats.json() << '\n';
+    cout << "  n = " << n << ", uniformes, BRIO: " << b.stats.json() << '\n';
+    cout << "  n = " << n << ", circulo, radial: " << r.stats.json() << '\n';
+}
+#endif
+
+int main(void){
+    srand(0);
+
+    cout << "Orden de insercion\n";
+    for(int n : {10000, 100000, 1000000, 4000000}) benchOrder(n);
+
+    cout << "Coordenadas compactas\n";
+    for(int n : {1000000, 4000000}){
+        benchLayout(n, RADIAL);
+        benchLayout(n, BRIO);
+    }
+
+    cout << "Rejillas\n";
+    for(int side : {300, 1000}) benchGrid(side);
+
+    cout << "Escala\n";
+    for(double scale : {1e-4, 1e4}){
+        benchScale(10, scale);
+        benchScale(5000, scale);
+    }
+
+#ifdef DELAUNAY_STATS
+    cout << "Contadores (DELAUNAY_STATS)\n";
+    for(int n : {10000, 100000}) benchStats(n);
+#endif
+    return 0;
+}
@@ -1,6 +1,7 @@
 #include "renderer.hpp"
 #include "shader.hpp"
 #include "delaunay.hpp"
+#include "lod.hpp"
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -16,6 +17,7 @@ float lastX = 960;
 float lastY = 540;
 float yaw = -90.0, roll, pitch, fov = 45.0;
 bool wireFrame = true;
+bool lodMode = false;            // Dibujar el nivel de detalle según la distancia
 // Posicion inicial de la camara
 glm::vec3 cameraPos = glm::vec3(0.0f, 0.5f, 2.0f);
 glm::vec3 cameraFront = glm::vec3(0.0f, 0.0f, -1.0f);
@@ -85,6 +87,9 @@ void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods
 				}
 				wireFrame = !wireFrame;
 				break;
+			case GLFW_KEY_L:
+				lodMode = !lodMode;
+				break;
 			case GLFW_KEY_1:
 				cameraPos = glm::vec3(0.0f, 4.0f, 0.0f); 
 				cameraFront = glm::vec3(0.0f, -1.0f, 0.0f);
@@ -223,10 +228,20 @@ int main(){
   float lastFrame = 0.0f;
 
 	
-	vector<unsigned int> indices = d.triangles;
 	vector<float> vertices = Point3ToVertices(points);
-	
-	Renderer* renderer = new Renderer(vertices, indices);
+
+	// Niveles de detalle con errores de 0.5%, 2% y 8% de la altura del terreno
+	double minY = points[0].y, maxY = points[0].y;
+	glm::vec3 center(0.0f);
+	for(const Point3& p: points){
+		minY = min(minY, p.y);
+		maxY = max(maxY, p.y);
+		center += glm::vec3(p.x, p.y, p.z) / float(points.size());
+	}
+	double height = max(maxY - minY, EPSILON);
+	TerrainLod lod(d, {0.005 * height, 0.02 * height, 0.08 * height});
+	// Se cambia de nivel cuando el error se ve de menos de 2 pixeles
+	Renderer* renderer = new Renderer(vertices, lod.levels, lod.switchDistances(2.0, 600.0, glm::radians(fov)));
 
   while (!glfwWindowShouldClose(window))
   {
@@ -251,7 +266,11 @@ int main(){
 		glm::mat4 mvp = proj * view * globalModelMatrix; 
 
 		if (trianglesToDraw > totalIndices) trianglesToDraw = totalIndices;
-    renderer->drawTriangles(shader.ID, mvp, globalModelMatrix, {1.0, 0.3, 0.5}, trianglesToDraw);
+		if (lodMode) {
+			renderer->drawLod(shader.ID, mvp, globalModelMatrix, {1.0, 0.3, 0.5}, glm::length(cameraPos - center));
+		} else {
+    	renderer->drawTriangles(shader.ID, mvp, globalModelMatrix, {1.0, 0.3, 0.5}, trianglesToDraw);
+		}
 		glPointSize(5.0f);
 
 		renderer->drawPoints(shader.ID, mvp, globalModelMatrix, {0,1,0});
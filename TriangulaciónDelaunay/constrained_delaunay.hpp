@@ -0,0 +1,279 @@
+#ifndef CONSTRAINED_DELAUNAY_H
+#define CONSTRAINED_DELAUNAY_H
+
+#include "dynamic_delaunay.hpp"
+#include <unordered_map>
+#include <deque>
+
+using namespace std;
+
+// Triangulación de Delaunay con aristas obligatorias (líneas de quiebre, bordes de polígonos).
+// insertConstraint(u, v) quita los triángulos que cruza el segmento u-v y vuelve a triangular
+// los dos pseudo-polígonos que quedan a cada lado. Las aristas restringidas se guardan en
+// `constraints` y legalize no las voltea, así que insert y move las respetan; un punto
+// insertado justo sobre una restricción la parte en dos.
+class ConstrainedDelaunay : public DynamicDelaunay {
+public:
+  ConstrainedDelaunay(const vector<Point3>& input, InsertionOrder order = BRIO, CoordinateLayout layout = POINTS)
+    : DynamicDelaunay(input, order, layout) {}
+
+  void insertConstraint(unsigned int u, unsigned int v);
+  bool isConstrained(unsigned int u, unsigned int v) const {
+    return constraints.count(edgeKey(min(u, v), max(u, v))) > 0;
+  }
+
+private:
+  vector<unsigned int> outgoing(unsigned int u);
+  void fillPseudoPolygon(const vector<unsigned int>& chain, unsigned int i, unsigned int j,
+                         unordered_map<unsigned long long, unsigned int>& open, vector<unsigned int>& added);
+};
+
+// Todos los halfedges que salen de u
+vector<unsigned int> ConstrainedDelaunay::outgoing(unsigned int u) {
+  unsigned int start = findEdge(u);
+  if (start == INVALID) throw runtime_error("insertConstraint: el vértice no está en la triangulación");
+  vector<unsigned int> out;
+  unsigned int e = start;
+  do {
+    out.push_back(e);
+    e = halfedges[prevHalfedge(e)];
+  } while (e != INVALID && e != start);
+  if (e == INVALID) {
+    // u está en la envolvente: falta el otro lado de start
+    e = halfedges[start];
+    while (e != INVALID) {
+      e = nextHalfedge(e);
+      out.push_back(e);
+      e = halfedges[e];
+    }
+  }
+  return out;
+}
+
+void ConstrainedDelaunay::insertConstraint(unsigned int u, unsigned int v) {
+  if (u == v) return;
+  const Point3& pu = points[u];
+  const Point3& pv = points[v];
+  double lenSq = distSq(pu.x, pu.z, pv.x, pv.z);
+  // Lado de w respecto a la recta u -> v y si cae entre u y v
+  auto side = [&](unsigned int w) {
+    return orient2d(pu.x, pu.z, pv.x, pv.z, points[w].x, points[w].z);
+  };
+  auto between = [&](unsigned int w) {
+    double dot = (points[w].x - pu.x) * (pv.x - pu.x) + (points[w].z - pu.z) * (pv.z - pu.z);
+    return side(w) == 0.0 && dot > 0 && dot < lenSq;
+  };
+
+  // Triángulo alrededor de u por el que sale el segmento
+  unsigned int crossing = INVALID;
+  for (unsigned int e : outgoing(u)) {
+    unsigned int b = triangles[nextHalfedge(e)];
+    unsigned int c = triangles[prevHalfedge(e)];
+    if (b == v || c == v) {
+      addConstraint(u, v);
+      return;
+    }
+    // Un vértice sobre el segmento lo parte en dos restricciones
+    for (unsigned int w : {b, c}) {
+      if (between(w)) {
+        insertConstraint(u, w);
+        insertConstraint(w, v);
+        return;
+      }
+    }
+    double sb = side(b), sc = side(c);
+    if ((sb > 0) == (sc > 0)) continue;
+    // u y v tienen que quedar de lados distintos de b-c
+    const Point3& pb = points[b];
+    const Point3& pc = points[c];
+    double su = orient2d(pb.x, pb.z, pc.x, pc.z, pu.x, pu.z);
+    double sv = orient2d(pb.x, pb.z, pc.x, pc.z, pv.x, pv.z);
+    if ((su > 0) != (sv > 0)) {
+      crossing = nextHalfedge(e);
+      break;
+    }
+  }
+  if (crossing == INVALID) throw runtime_error("insertConstraint: el segmento no cruza la triangulación");
+
+  // Caminar por los triángulos que cruza el segmento juntando los vértices de cada lado
+  vector<unsigned int> dead{crossing / 3};
+  vector<unsigned int> left{u}, right{u};
+  auto addSide = [&](unsigned int w) {
+    vector<unsigned int>& chain = side(w) > 0 ? left : right;
+    if (chain.back() != w) chain.push_back(w);
+  };
+  addSide(triangles[crossing]);
+  addSide(triangles[nextHalfedge(crossing)]);
+  unsigned int end = v;
+  unsigned int h = crossing;
+  while (true) {
+    if (isConstrained(triangles[h], triangles[nextHalfedge(h)])) {
+      throw runtime_error("insertConstraint: el segmento cruza otra restricción");
+    }
+    unsigned int tw = halfedges[h];
+    if (tw == INVALID) throw runtime_error("insertConstraint: el segmento sale de la envolvente");
+    if (dead.size() > triangles.size() / 3) throw runtime_error("insertConstraint: la caminata no termina");
+    dead.push_back(tw / 3);
+    unsigned int w = triangles[prevHalfedge(tw)];
+    if (w == v) break;
+    if (between(w)) {
+      end = w;
+      break;
+    }
+    addSide(w);
+    unsigned int h1 = nextHalfedge(tw);
+    bool s1 = side(triangles[h1]) > 0, s2 = side(triangles[nextHalfedge(h1)]) > 0;
+    h = s1 != s2 ? h1 : prevHalfedge(tw);
+  }
+  left.push_back(end);
+  right.push_back(end);
+
+  // Aristas del borde de la cavidad: su halfedge de afuera espera al triángulo nuevo
+  unordered_map<unsigned long long, unsigned int> open;
+  for (unsigned int t : dead) {
+    for (unsigned int e = 3 * t; e < 3 * t + 3; e++) {
+      unsigned int tw = halfedges[e];
+      if (tw != INVALID && find(dead.begin(), dead.end(), tw / 3) == dead.end()) {
+        open[edgeKey(triangles[tw], triangles[nextHalfedge(tw)])] = tw;
+      }
+    }
+  }
+  for (unsigned int t : dead) {
+    for (unsigned int e = 3 * t; e < 3 * t + 3; e++) {
+      triangles[e] = INVALID;
+      halfedges[e] = INVALID;
+    }
+    freeTriangles.push_back(t);
+  }
+
+  vector<unsigned int> added;
+  fillPseudoPolygon(left, 0, left.size() - 1, open, added);
+  fillPseudoPolygon(right, 0, right.size() - 1, open, added);
+
+  // Lo que quedó sin pareja en los triángulos nuevos es envolvente
+  for (auto& kv : open) {
+    unsigned int e = kv.second;
+    if (find(added.begin(), added.end(), e / 3) != added.end()) hull_tri[triangles[e]] = e;
+  }
+  if (!added.empty()) lastTri = added.back();
+  addConstraint(u, end);
+  if (end != v) insertConstraint(end, v);
+}
+
+// Triangula chain[i..j], que tiene la arista chain[i]-chain[j] como base: el tercer vértice es
+// el que deja el círculo vacío de los demás (el primero, y se cambia por cualquiera que quede
+// dentro del círculo actual). Luego cada lado por separado.
+void ConstrainedDelaunay::fillPseudoPolygon(const vector<unsigned int>& chain, unsigned int i, unsigned int j,
+                                            unordered_map<unsigned long long, unsigned int>& open,
+                                            vector<unsigned int>& added) {
+  if (j - i < 2) return;
+  unsigned int a = chain[i], b = chain[j];
+  unsigned int c = i + 1;
+  for (unsigned int k = i + 2; k < j; k++) {
+    unsigned int p0 = a, p1 = chain[c], p2 = b;
+    if (orient(points[p0].x, points[p0].z, points[p1].x, points[p1].z, points[p2].x, points[p2].z)) swap(p1, p2);
+    const Point3& q = points[chain[k]];
+    if (InCircle(points[p0].x, points[p0].z, points[p1].x, points[p1].z, points[p2].x, points[p2].z, q.x, q.z,
+                 p0, p1, p2, chain[k])) c = k;
+  }
+
+  unsigned int p0 = a, p1 = chain[c], p2 = b;
+  if (orient(points[p0].x, points[p0].z, points[p1].x, points[p1].z, points[p2].x, points[p2].z)) swap(p1, p2);
+  unsigned int t = addTriangle(p0, p1, p2, INVALID, INVALID, INVALID);
+  added.push_back(t / 3);
+  for (unsigned int e = t; e < t + 3; e++) {
+    unsigned int x = triangles[e], y = triangles[nextHalfedge(e)];
+    auto it = open.find(edgeKey(y, x));
+    if (it != open.end()) {
+      link(e, it->second);
+      open.erase(it);
+    } else {
+      open[edgeKey(x, y)] = e;
+    }
+  }
+
+  fillPseudoPolygon(chain, i, c, open, added);
+  fillPseudoPolygon(chain, c, j, open, added);
+}
+
+// Triangula un polígono con hoyos: rings[0] es el borde y los demás son hoyos (sirve cualquier
+// orientación y también islas dentro de los hoyos). Regresa los triángulos de adentro como
+// índices a los puntos de los anillos puestos uno tras otro.
+// Los bordes se insertan como restricciones y de ahí se llena desde la envolvente: cada vez
+// que se cruza una restricción se pasa de afuera a adentro o al revés.
+vector<unsigned int> triangulatePolygon(const vector<vector<Point3>>& rings) {
+  vector<Point3> all;
+  vector<pair<unsigned int, unsigned int>> edges;
+  for (auto& ring : rings) {
+    unsigned int base = all.size();
+    for (unsigned int k = 0; k < ring.size(); k++) {
+      all.push_back(ring[k]);
+      edges.push_back({base + k, base + (k + 1) % ring.size()});
+    }
+  }
+
+  // Los puntos repetidos (un hoyo que toca al borde) se vuelven uno solo
+  vector<unsigned int> order(all.size()), rep(all.size());
+  for (unsigned int k = 0; k < all.size(); k++) order[k] = k;
+  sort(order.begin(), order.end(), [&](unsigned int a, unsigned int b) {
+    if (all[a].x != all[b].x) return all[a].x < all[b].x;
+    if (all[a].z != all[b].z) return all[a].z < all[b].z;
+    return a < b;
+  });
+  vector<Point3> unique;
+  vector<unsigned int> original;  // Índice en `all` de cada punto único
+  for (unsigned int k = 0; k < order.size(); k++) {
+    unsigned int i = order[k];
+    if (k > 0 && check_pts_equal(all[i].x, all[i].z, unique.back().x, unique.back().z)) {
+      rep[i] = unique.size() - 1;
+      continue;
+    }
+    rep[i] = unique.size();
+    unique.push_back(all[i]);
+    original.push_back(i);
+  }
+
+  ConstrainedDelaunay cd(unique);
+  for (auto& e : edges) cd.insertConstraint(rep[e.first], rep[e.second]);
+
+  // 0-1 BFS: profundidad = restricciones cruzadas desde afuera; adentro son las impares
+  const vector<unsigned int>& T = cd.triangles;
+  const vector<unsigned int>& H = cd.halfedges;
+  unsigned int m = T.size() / 3;
+  vector<unsigned int> depth(m, INVALID);
+  deque<unsigned int> queue;
+  auto crossesBorder = [&](unsigned int e) { return cd.isConstrained(T[e], T[nextHalfedge(e)]); };
+  for (unsigned int e = 0; e < T.size(); e++) {
+    if (T[e] == INVALID || H[e] != INVALID) continue;
+    unsigned int d = crossesBorder(e) ? 1 : 0;
+    if (d < depth[e / 3]) {
+      depth[e / 3] = d;
+      if (d == 0) queue.push_front(e / 3);
+      else queue.push_back(e / 3);
+    }
+  }
+  while (!queue.empty()) {
+    unsigned int t = queue.front();
+    queue.pop_front();
+    for (unsigned int e = 3 * t; e < 3 * t + 3; e++) {
+      if (H[e] == INVALID) continue;
+      unsigned int n = H[e] / 3;
+      bool border = crossesBorder(e);
+      unsigned int d = depth[t] + (border ? 1 : 0);
+      if (d < depth[n]) {
+        depth[n] = d;
+        if (border) queue.push_back(n);
+        else queue.push_front(n);
+      }
+    }
+  }
+
+  vector<unsigned int> result;
+  for (unsigned int t = 0; t < m; t++) {
+    if (T[3 * t] == INVALID || depth[t] == INVALID || depth[t] % 2 == 0) continue;
+    for (unsigned int j = 0; j < 3; j++) result.push_back(original[T[3 * t + j]]);
+  }
+  return result;
+}
+
+#endif
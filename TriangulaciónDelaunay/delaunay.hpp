@@ -9,6 +9,12 @@
 #include <limits>
 #include <stdexcept>
 #include <iostream>
+#include <random>
+#include <thread>
+#include <cstring>
+#include <unordered_set>
+#include <unordered_map>
+#include <bit>
 
 #define INVALID std::numeric_limits<unsigned int>::max()
 #define EPSILON 1e-9 
@@ -27,7 +33,8 @@ inline double distSq(double ax, double ay, double bx, double by) {
   return dx * dx + dy * dy;
 }
 
-// Calcula el radio al cuadrado del círculo circunscrito al triángulo (a,b,c)
+// Calcula el radio al cuadrado del círculo circunscrito al triángulo (a,b,c); los colineales
+// se descartan antes con orient2d, aquí solo se evita dividir entre cero
 inline double circumradius(double ax, double ay, double bx, double by, double cx, double cy) {
   double dx = bx - ax;
   double dy = by - ay;
@@ -38,8 +45,7 @@ inline double circumradius(double ax, double ay, double bx, double by, double cx
   double cl = ex * ex + ey * ey;  
   double d = dx * ey - dy * ex;   
   
-  // Puntos colineales si d ≈ 0
-  if (fabs(d) < EPSILON) {
+  if (d == 0.0) {
     return std::numeric_limits<double>::max();
   }
   
@@ -50,32 +56,273 @@ inline double circumradius(double ax, double ay, double bx, double by, double cx
   return x * x + y * y;  
 }
 
-// Prueba de orientación CCW
+// Predicados exactos (Shewchuk): primero se evalúa el determinante en double y, si su valor
+// está lejos de cero comparado con la cota del error de redondeo, su signo es correcto. Si no,
+// se recalcula sin redondeo con expansiones: un número es la suma exacta de varios double que no
+// se traslapan, del de menor a mayor magnitud, y su signo es el del último. Necesitan aritmética
+// IEEE sin reordenar (nada de -ffast-math ni contracción a FMA).
+#define PREDICATE_EPS 1.1102230246251565e-16    // 2^-53
+#define ORIENT_ERRBOUND ((3.0 + 16.0 * PREDICATE_EPS) * PREDICATE_EPS)
+#define INCIRCLE_ERRBOUND ((11.0 + 96.0 * PREDICATE_EPS) * PREDICATE_EPS)
+
+// a + b = s + e exactamente
+inline void twoSum(double a, double b, double& s, double& e) {
+  s = a + b;
+  double bv = s - a;
+  double av = s - bv;
+  e = (a - av) + (b - bv);
+}
+
+// a * b = p + e exactamente (división de Dekker en mitades de 26 bits)
+inline void twoProduct(double a, double b, double& p, double& e) {
+  p = a * b;
+  double c = 134217729.0 * a;
+  double ah = c - (c - a), al = a - ah;
+  c = 134217729.0 * b;
+  double bh = c - (c - b), bl = b - bh;
+  e = al * bl - (((p - ah * bh) - al * bh) - ah * bl);
+}
+
+// a - b exactamente en h; regresa el número de términos (uno si la resta no redondeó)
+inline unsigned int twoDiff(double a, double b, double* h) {
+  double d = a - b;
+  double bv = a - d;
+  double av = d + bv;
+  double e = (a - av) + (bv - b);
+  if (e == 0.0) {
+    h[0] = d;
+    return 1;
+  }
+  h[0] = e;
+  h[1] = d;
+  return 2;
+}
+
+// h = e + f sin ceros; regresa el número de términos. h no puede ser e ni f.
+inline unsigned int expansionSum(unsigned int elen, const double* e, unsigned int flen, const double* f, double* h) {
+  if (elen == 1) {
+    swap(elen, flen);
+    swap(e, f);
+  }
+  if (flen == 1) {
+    // Un solo término: se va sumando de menor a mayor, sin mezclar (y sin ramas por magnitud)
+    unsigned int n = 0;
+    double q = f[0];
+    for (unsigned int i = 0; i < elen; i++) {
+      double s, t;
+      twoSum(q, e[i], s, t);
+      if (t != 0.0) h[n++] = t;
+      q = s;
+    }
+    if (q != 0.0 || n == 0) h[n++] = q;
+    return n;
+  }
+  unsigned int i = 0, j = 0, n = 0;
+  // Siguiente término de la mezcla de e y f por magnitud
+  auto next = [&]() { return j == flen || (i < elen && fabs(e[i]) < fabs(f[j])) ? e[i++] : f[j++]; };
+  double q = next();
+  while (i < elen || j < flen) {
+    double s, t;
+    twoSum(q, next(), s, t);
+    if (t != 0.0) h[n++] = t;
+    q = s;
+  }
+  if (q != 0.0 || n == 0) h[n++] = q;
+  return n;
+}
+
+// h = e * b sin ceros, con a lo más 2 * elen términos
+inline unsigned int scaleExpansion(unsigned int elen, const double* e, double b, double* h) {
+  unsigned int n = 0;
+  double q, t;
+  twoProduct(e[0], b, q, t);
+  if (t != 0.0) h[n++] = t;
+  for (unsigned int i = 1; i < elen; i++) {
+    double p1, p0, s;
+    twoProduct(e[i], b, p1, p0);
+    twoSum(q, p0, s, t);
+    if (t != 0.0) h[n++] = t;
+    q = p1 + s;              // Suma rápida: |p1| >= |s|
+    t = s - (q - p1);
+    if (t != 0.0) h[n++] = t;
+  }
+  if (q != 0.0 || n == 0) h[n++] = q;
+  return n;
+}
+
+// h = e * f, con a lo más 2 * elen * flen términos; elen y flen de a lo más 16
+inline unsigned int expansionProduct(unsigned int elen, const double* e, unsigned int flen, const double* f, double* h) {
+  double part[32], acc[512];
+  unsigned int n = scaleExpansion(elen, e, f[0], h);
+  for (unsigned int k = 1; k < flen; k++) {
+    unsigned int m = scaleExpansion(elen, e, f[k], part);
+    copy(h, h + n, acc);
+    n = expansionSum(n, acc, m, part, h);
+  }
+  return n;
+}
+
+// a * b - c * d exactamente en h (a lo más 4 términos)
+inline unsigned int twoTwoDiff(double a, double b, double c, double d, double* h) {
+  double p[2], q[2];
+  twoProduct(a, b, p[1], p[0]);
+  twoProduct(-c, d, q[1], q[0]);
+  // Sin las colas que salieron cero (productos exactos)
+  unsigned int np = p[0] == 0.0 ? 1 : 2, nq = q[0] == 0.0 ? 1 : 2;
+  return expansionSum(np, p + 2 - np, nq, q + 2 - nq, h);
+}
+
+// Signo exacto de orient2d cuando el filtro no alcanzó
+inline double orient2dExact(double ax, double ay, double bx, double by, double cx, double cy) {
+  double acx[2], acy[2], bcx[2], bcy[2], left[8], right[8], det[16];
+  unsigned int nacx = twoDiff(ax, cx, acx), nacy = twoDiff(ay, cy, acy);
+  unsigned int nbcx = twoDiff(bx, cx, bcx), nbcy = twoDiff(by, cy, bcy);
+  if (nacx + nacy + nbcx + nbcy == 4) return det[twoTwoDiff(acx[0], bcy[0], acy[0], bcx[0], det) - 1];
+  unsigned int nl = expansionProduct(nacx, acx, nbcy, bcy, left);
+  unsigned int nr = expansionProduct(nacy, acy, nbcx, bcx, right);
+  for (unsigned int k = 0; k < nr; k++) right[k] = -right[k];
+  return det[expansionSum(nl, left, nr, right, det) - 1];
+}
+
+// lift * cross con lift = x^2 + y^2, todo exacto, en h (a lo más 32 términos)
+inline unsigned int liftTimes(double x, double y, unsigned int n, const double* cross, double* h) {
+  double t1[8], t2[16], u1[8], u2[16];
+  unsigned int n1 = scaleExpansion(n, cross, x, t1);
+  n1 = scaleExpansion(n1, t1, x, t2);
+  unsigned int n2 = scaleExpansion(n, cross, y, u1);
+  n2 = scaleExpansion(n2, u1, y, u2);
+  return expansionSum(n1, t2, n2, u2, h);
+}
+
+// incircle con las restas como expansiones (ex[k] = x del punto k menos dx, igual con y)
+inline double incircleExpansion(double ex[3][2], const unsigned int nx[3], double ey[3][2], const unsigned int ny[3]) {
+  double sum[1536], tmp[1536];
+  unsigned int n = 0;
+  for (unsigned int k = 0; k < 3; k++) {
+    unsigned int k1 = (k + 1) % 3, k2 = (k + 2) % 3;
+    double xx[8], yy[8], lift[16], p[8], q[8], cross[16], term[512];
+    unsigned int nxx = expansionProduct(nx[k], ex[k], nx[k], ex[k], xx);
+    unsigned int nyy = expansionProduct(ny[k], ey[k], ny[k], ey[k], yy);
+    unsigned int nlift = expansionSum(nxx, xx, nyy, yy, lift);
+    unsigned int np = expansionProduct(nx[k1], ex[k1], ny[k2], ey[k2], p);
+    unsigned int nq = expansionProduct(nx[k2], ex[k2], ny[k1], ey[k1], q);
+    for (unsigned int j = 0; j < nq; j++) q[j] = -q[j];
+    unsigned int ncross = expansionSum(np, p, nq, q, cross);
+    unsigned int nterm = expansionProduct(nlift, lift, ncross, cross, term);
+    if (n == 0) {
+      copy(term, term + nterm, sum);
+      n = nterm;
+    } else {
+      copy(sum, sum + n, tmp);
+      n = expansionSum(n, tmp, nterm, term, sum);
+    }
+  }
+  return sum[n - 1];
+}
+
+// Signo exacto de incircle cuando el filtro no alcanzó
+inline double incircleExact(double ax, double ay, double bx, double by, double cx, double cy, double dx, double dy) {
+  double ex[3][2], ey[3][2];
+  unsigned int nx[3], ny[3];
+  nx[0] = twoDiff(ax, dx, ex[0]);
+  nx[1] = twoDiff(bx, dx, ex[1]);
+  nx[2] = twoDiff(cx, dx, ex[2]);
+  ny[0] = twoDiff(ay, dy, ey[0]);
+  ny[1] = twoDiff(by, dy, ey[1]);
+  ny[2] = twoDiff(cy, dy, ey[2]);
+
+  // Restas sin redondeo (lo normal en rejillas): expansiones cortas y de tamaño fijo
+  if (nx[0] + nx[1] + nx[2] + ny[0] + ny[1] + ny[2] == 6) {
+    double cross[4], part[3][32], ab[64], det[96];
+    for (unsigned int k = 0; k < 3; k++) {
+      unsigned int k1 = (k + 1) % 3, k2 = (k + 2) % 3;
+      unsigned int n = twoTwoDiff(ex[k1][0], ey[k2][0], ex[k2][0], ey[k1][0], cross);
+      nx[k] = liftTimes(ex[k][0], ey[k][0], n, cross, part[k]);
+    }
+    unsigned int n = expansionSum(nx[0], part[0], nx[1], part[1], ab);
+    return det[expansionSum(n, ab, nx[2], part[2], det) - 1];
+  }
+
+  return incircleExpansion(ex, nx, ey, ny);
+}
+
+// Positivo si (a, b, c) gira en sentido antihorario, negativo si en horario, cero si son
+// colineales; el signo siempre es exacto
+inline double orient2d(double ax, double ay, double bx, double by, double cx, double cy) {
+  double detLeft = (ax - cx) * (by - cy);
+  double detRight = (ay - cy) * (bx - cx);
+  double det = detLeft - detRight;
+  // Sin ramas por el signo de cada producto: con puntos al azar no se pueden predecir
+  if (fabs(det) >= ORIENT_ERRBOUND * (fabs(detLeft) + fabs(detRight))) return det;
+  return orient2dExact(ax, ay, bx, by, cx, cy);
+}
+
+// Positivo si d está dentro del círculo de (a, b, c) en sentido antihorario, negativo si está
+// afuera, cero si los cuatro son cocirculares; el signo siempre es exacto
+inline double incircle(double ax, double ay, double bx, double by, double cx, double cy, double dx, double dy) {
+  double adx = ax - dx, ady = ay - dy;
+  double bdx = bx - dx, bdy = by - dy;
+  double cdx = cx - dx, cdy = cy - dy;
+  double bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+  double cdxady = cdx * ady, adxcdy = adx * cdy;
+  double adxbdy = adx * bdy, bdxady = bdx * ady;
+  double alift = adx * adx + ady * ady;
+  double blift = bdx * bdx + bdy * bdy;
+  double clift = cdx * cdx + cdy * cdy;
+  double det = alift * (bdxcdy - cdxbdy) + blift * (cdxady - adxcdy) + clift * (adxbdy - bdxady);
+  // La cota de Shewchuk usa la suma de los productos en valor absoluto; por Cauchy-Schwarz
+  // |bdx cdy| + |cdx bdy| <= sqrt(blift clift) <= max(lift), así que esto la acota con menos
+  // operaciones (el ε de más en INCIRCLE_ERRBOUND cubre el redondeo de la cota)
+  double bound = (alift + blift + clift) * max(alift, max(blift, clift));
+  if (fabs(det) > INCIRCLE_ERRBOUND * bound) return det;
+  return incircleExact(ax, ay, bx, by, cx, cy, dx, dy);
+}
+
+// Prueba de orientación: true si (p, q, r) gira en sentido antihorario o son colineales
 inline bool orient(double px, double py, double qx, double qy, double rx, double ry) {
-  return (qy - py) * (rx - qx) - (qx - px) * (ry - qy) < EPSILON;
+  return orient2d(px, py, qx, qy, rx, ry) >= 0.0;
 }
 
-// Retorna true si punto p está dentro del círculo circunscrito de triángulo a-b-c
-// Calcula usando determinante de matriz 4x4 simplificado
+// Retorna true si punto p está dentro del círculo circunscrito de triángulo a-b-c, con (a, b, c)
+// en el sentido de los triángulos de la malla (horario en x, z)
 inline bool InCircle(double ax, double ay, double bx, double by, double cx, double cy, double px, double py) {
-  double dx = ax - px;
-  double dy = ay - py;
-  double ex = bx - px;
-  double ey = by - py;
-  double fx = cx - px;
-  double fy = cy - py;
-  
-  double ap = dx * dx + dy * dy;
-  double bp = ex * ex + ey * ey;
-  double cp = fx * fx + fy * fy;
-  
-  // Determinante de la matriz de puntos orientados
-  return (dx * (ey * cp - bp * fy) - dy * (ex * cp - bp * fx) + ap * (ex * fy - ey * fx)) < 0.0;
+  return incircle(ax, ay, bx, by, cx, cy, px, py) < 0.0;
 }
 
-// Compara si dos puntos 2D son iguales 
+// Empate de la prueba del círculo (a, b, c, p cocirculares), roto con una perturbación
+// simbólica: cada punto sube en el paraboloide de levantamiento un infinitésimo que es mayor
+// mientras mayor es su índice. El determinante es lineal en la altura de cada punto, así que el
+// signo lo da el cofactor (una orientación de los otros tres) del punto de mayor índice que no
+// sea cero.
+inline bool inCircleTie(double ax, double ay, double bx, double by, double cx, double cy, double px, double py,
+                        unsigned int ia, unsigned int ib, unsigned int ic, unsigned int ip) {
+  // Puntos de mayor a menor índice, con el signo de su cofactor
+  struct { unsigned int i; double s; } v[4] = {
+    {ia, orient2d(bx, by, cx, cy, px, py)},
+    {ib, -orient2d(ax, ay, cx, cy, px, py)},
+    {ic, orient2d(ax, ay, bx, by, px, py)},
+    {ip, -orient2d(ax, ay, bx, by, cx, cy)}};
+  sort(begin(v), end(v), [](const auto& a, const auto& b) { return a.i > b.i; });
+  for (auto& k : v) {
+    if (k.s != 0.0) return k.s < 0.0;
+  }
+  return false;
+}
+
+// InCircle con los empates rotos por índice: ningún cuadrilátero queda empatado y la
+// triangulación es única, así que no depende del orden de inserción y legalize nunca voltea
+// una arista de ida y vuelta
+inline bool InCircle(double ax, double ay, double bx, double by, double cx, double cy, double px, double py,
+                     unsigned int ia, unsigned int ib, unsigned int ic, unsigned int ip) {
+  double det = incircle(ax, ay, bx, by, cx, cy, px, py);
+  if (det != 0.0) return det < 0.0;
+  return inCircleTie(ax, ay, bx, by, cx, cy, px, py, ia, ib, ic, ip);
+}
+
+// Compara si dos puntos 2D son iguales. Es exacta: con los predicados exactos dos puntos
+// distintos, por cerca que estén, se triangulan bien, y una tolerancia fija dependería de la escala
 inline bool check_pts_equal(double x1, double y1, double x2, double y2) {
-  return fabs(x1 - x2) <= EPSILON && fabs(y1 - y2) <= EPSILON;
+  return x1 == x2 && y1 == y2;
 }
 
 // Monotona respecto al ángulo pero más eficiente que atan2
@@ -89,31 +336,187 @@ inline unsigned int fast_mod(unsigned int i, unsigned int c) {
   return i >= c ? i % c : i;
 }
 
-// Comparador para ordenar puntos por distancia desde el centro 
-// Si distancias iguales, desempata por coordenada x, luego z
-struct compare {
-  const vector<Point3>& points;
-  double cx, cy;
-  
-  compare(const vector<Point3>& p, double center_x, double center_y) : points(p), cx(center_x), cy(center_y) {}
-  
-  bool operator()(unsigned int i, unsigned int j) const {
-    double d1 = distSq(points[i].x, points[i].z, cx, cy);
-    double d2 = distSq(points[j].x, points[j].z, cx, cy);
-    
-    if (fabs(d1 - d2) > EPSILON) {
-      return d1 < d2;
+// Halfedge siguiente y anterior dentro del mismo triángulo
+inline unsigned int nextHalfedge(unsigned int e) { return e % 3 == 2 ? e - 2 : e + 1; }
+inline unsigned int prevHalfedge(unsigned int e) { return e % 3 == 0 ? e + 2 : e - 1; }
+
+// Llave de la arista dirigida u -> v
+inline unsigned long long edgeKey(unsigned int u, unsigned int v) {
+  return (static_cast<unsigned long long>(u) << 32) | v;
+}
+
+// Par (llave, índice) para ordenar los puntos por una llave precalculada
+typedef pair<unsigned long long, unsigned int> SortKey;
+
+// Bits de un double no negativo como entero; el orden de los enteros es el de los double
+inline unsigned long long orderedBits(double v) {
+  unsigned long long b;
+  memcpy(&b, &v, sizeof(b));
+  return b;
+}
+
+// Revuelve los bits (el final de splitmix64): cada bit de la salida depende de todos los de la entrada
+inline unsigned long long mixBits(unsigned long long z) {
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+  return z ^ (z >> 31);
+}
+
+// Llama f(inicio, fin, k) sobre `threads` tramos de [0, n), cada uno en su hilo
+template<class F>
+void forChunks(unsigned int n, unsigned int threads, F f) {
+  if (threads <= 1) {
+    f(0u, n, 0u);
+    return;
+  }
+  vector<thread> pool;
+  for (unsigned int k = 0; k < threads; k++) {
+    unsigned int lo = static_cast<unsigned long long>(n) * k / threads;
+    unsigned int hi = static_cast<unsigned long long>(n) * (k + 1) / threads;
+    pool.emplace_back(f, lo, hi, k);
+  }
+  for (auto& th : pool) th.join();
+}
+
+// Con menos elementos por hilo no vale la pena repartir el ordenamiento
+#define SORT_MIN_PER_THREAD (1u << 17)
+
+inline unsigned int sortThreads(unsigned int n) {
+  return max(1u, min(thread::hardware_concurrency(), n / SORT_MIN_PER_THREAD));
+}
+
+// Ordena por llave con radix sort LSD, 11 bits por pasada. Es estable: a igual llave queda
+// primero el que ya estaba primero. Cada pasada se reparte entre hilos: cada uno cuenta su
+// tramo y luego escribe en su parte de cada cubeta. Se saltan las pasadas en las que todas
+// las llaves tienen el mismo dígito (los bits altos de distancias parecidas).
+inline void sortKeys(vector<SortKey>& keys) {
+  const unsigned int BITS = 11, BUCKETS = 1u << BITS;
+  unsigned int n = keys.size();
+  if (n < (1u << 16)) {
+    // Con el índice como segundo criterio también es estable si los índices venían en orden
+    sort(keys.begin(), keys.end());
+    return;
+  }
+
+  unsigned int threads = sortThreads(n);
+  vector<SortKey> tmp(n);
+  vector<unsigned int> count(threads * BUCKETS);
+  for (unsigned int shift = 0; shift < 64; shift += BITS) {
+    fill(count.begin(), count.end(), 0u);
+    forChunks(n, threads, [&](unsigned int lo, unsigned int hi, unsigned int k) {
+      unsigned int* c = &count[k * BUCKETS];
+      for (unsigned int i = lo; i < hi; i++) c[(keys[i].first >> shift) & (BUCKETS - 1)]++;
+    });
+
+    // Inicio de cada (cubeta, hilo) en la salida
+    unsigned int sum = 0;
+    bool trivial = false;
+    for (unsigned int b = 0; b < BUCKETS; b++) {
+      unsigned int total = 0;
+      for (unsigned int k = 0; k < threads; k++) total += count[k * BUCKETS + b];
+      if (total == n) trivial = true;
+      for (unsigned int k = 0; k < threads; k++) {
+        unsigned int c = count[k * BUCKETS + b];
+        count[k * BUCKETS + b] = sum;
+        sum += c;
+      }
     }
-    
-    double diff_x = points[i].x - points[j].x;
-    if (fabs(diff_x) > EPSILON) {
-      return diff_x < 0.0;
+    if (trivial) continue;
+
+    forChunks(n, threads, [&](unsigned int lo, unsigned int hi, unsigned int k) {
+      unsigned int* c = &count[k * BUCKETS];
+      for (unsigned int i = lo; i < hi; i++) tmp[c[(keys[i].first >> shift) & (BUCKETS - 1)]++] = keys[i];
+    });
+    keys.swap(tmp);
+  }
+}
+
+// Índice del punto (x, y), con coordenadas en [0, 2^16), sobre la curva de Hilbert
+inline unsigned int hilbertIndex(unsigned int x, unsigned int y) {
+  const unsigned int n = 1u << 16;
+  unsigned int d = 0;
+  for (unsigned int s = n / 2; s > 0; s /= 2) {
+    unsigned int rx = (x & s) > 0;
+    unsigned int ry = (y & s) > 0;
+    d += s * s * ((3 * rx) ^ ry);
+    // Rotar el cuadrante para que la curva siga conectada
+    if (ry == 0) {
+      if (rx == 1) {
+        x = n - 1 - x;
+        y = n - 1 - y;
+      }
+      swap(x, y);
     }
-    
-    return points[i].z < points[j].z;
+  }
+  return d;
+}
+
+// Con DELAUNAY_STATS definido antes de incluir, cada Delaunay junta en `stats` contadores de
+// los ciclos internos y el tiempo de cada fase; sin él DELAUNAY_COUNT y compañía no generan
+// código y la clase no tiene el miembro.
+#ifdef DELAUNAY_STATS
+#include <chrono>
+#include <sstream>
+
+struct DelaunayStats {
+  long long hashLookups = 0, hashProbes = 0;      // Búsquedas en la tabla hash y celdas revisadas
+  long long hullWalks = 0, hullWalkSteps = 0;     // Búsquedas de la arista visible y aristas revisadas
+  long long hullExtendSteps = 0;                  // Triángulos agregados al extender sobre la envolvente
+  long long locates = 0, locateSteps = 0;         // Caminatas de BRIO y triángulos visitados
+  long long legalizeCalls = 0, flips = 0;
+  long long maxStackDepth = 0;                    // Máximo de illegalEdgeStack
+  long long hullRescans = 0, hullRescanSteps = 0; // Recorridos O(h) de hull_tri en legalize
+  double bboxMs = 0, seedMs = 0, sortMs = 0, insertMs = 0;
+
+  chrono::steady_clock::time_point mark;
+  void start() { mark = chrono::steady_clock::now(); }
+  // Suma a phase el tiempo desde la marca anterior y mueve la marca
+  void lap(double& phase) {
+    chrono::steady_clock::time_point now = chrono::steady_clock::now();
+    phase += chrono::duration<double, milli>(now - mark).count();
+    mark = now;
+  }
+
+  string json() const {
+    ostringstream out;
+    out << "{\"hashLookups\": " << hashLookups << ", \"hashProbes\": " << hashProbes
+        << ", \"hullWalks\": " << hullWalks << ", \"hullWalkSteps\": " << hullWalkSteps
+        << ", \"hullExtendSteps\": " << hullExtendSteps
+        << ", \"locates\": " << locates << ", \"locateSteps\": " << locateSteps
+        << ", \"legalizeCalls\": " << legalizeCalls << ", \"flips\": " << flips
+        << ", \"maxStackDepth\": " << maxStackDepth
+        << ", \"hullRescans\": " << hullRescans << ", \"hullRescanSteps\": " << hullRescanSteps
+        << ", \"ms\": {\"bbox\": " << bboxMs << ", \"seed\": " << seedMs
+        << ", \"sort\": " << sortMs << ", \"insert\": " << insertMs << "}}";
+    return out.str();
   }
 };
 
+#define DELAUNAY_COUNT(c) (stats.c++)
+#define DELAUNAY_MAX(c, v) (stats.c = max(stats.c, static_cast<long long>(v)))
+#define DELAUNAY_START() stats.start()
+#define DELAUNAY_LAP(phase) stats.lap(stats.phase)
+#else
+#define DELAUNAY_COUNT(c) ((void)0)
+#define DELAUNAY_MAX(c, v) ((void)0)
+#define DELAUNAY_START() ((void)0)
+#define DELAUNAY_LAP(phase) ((void)0)
+#endif
+
+// Orden en que se insertan los puntos
+// RADIAL: por distancia al centro del triángulo inicial; cada punto queda fuera de la envolvente
+//         y se encuentra con la tabla hash (sweep-hull).
+// BRIO:   rondas aleatorias que se duplican en tamaño y, dentro de cada ronda, orden de Hilbert.
+//         Los puntos consecutivos quedan cerca, así que se localizan caminando desde el último
+//         triángulo creado y todo lo que se toca sigue en caché.
+enum InsertionOrder { RADIAL, BRIO };
+
+// De dónde leen las coordenadas los predicados
+// POINTS:  directamente de points; cada Point3 ocupa 24 bytes y la y viaja a la caché sin usarse.
+// COMPACT: de una copia de (x, z) seguidos, 16 bytes por punto, que se hace al construir. Los
+//          valores son los mismos, así que la triangulación sale idéntica.
+enum CoordinateLayout { POINTS, COMPACT };
+
 class Delaunay {
 public:
   const vector<Point3>& points;       
@@ -123,29 +526,113 @@ public:
   vector<unsigned int> hull_next;
   vector<unsigned int> hull_tri;      
   unsigned int hull_start;
+#ifdef DELAUNAY_STATS
+  DelaunayStats stats;
+#endif
   
-  Delaunay(const vector<Point3>& input);
+  Delaunay(const vector<Point3>& input, InsertionOrder order = RADIAL, CoordinateLayout layout = POINTS);
   double getHullArea();                
   
-private:
+protected:
+  unsigned int lastTri = 0;               // Donde empieza la siguiente caminata (modo BRIO)
+  vector<unsigned int> freeTriangles;     // Triángulos borrados que addTriangle reutiliza
+  unordered_set<unsigned long long> constraints;  // Aristas que legalize no voltea, edgeKey(menor, mayor)
+  unordered_map<unsigned int, vector<unsigned int>> constraintsAt;  // Otro extremo de las restricciones de cada vértice
+
+  CoordinateLayout layout;
+  const double* coords = nullptr;         // x del punto i en coords[coordStride * i], z justo después de la y o de la x
+  unsigned int coordStride = 3;
+  vector<double> compactCoords;
+
   vector<unsigned int> hashTable;         
   double circumCenter_x, circumCenter_y;       
   unsigned int hashTableSize;            
   vector<unsigned int> illegalEdgeStack;
   
+  void build(InsertionOrder order);
   unsigned int legalize(unsigned int a);                           
+  void addHullPoint(unsigned int i, unsigned int e, bool walkBack);
+  bool insertOutside(unsigned int i, unsigned int a);
+  bool insertPoint(unsigned int i);
+  void splitEdge(unsigned int i, unsigned int e);
+  unsigned int locate(double x, double y, bool& outside);
+  void radialOrder(vector<unsigned int>& ids);
+  void brioOrder(vector<unsigned int>& ids, double min_x, double min_y, double max_x, double max_y);
   unsigned int hashKey(double x, double y) const;                  
   unsigned int addTriangle(unsigned int i0, unsigned int i1, unsigned int i2, unsigned int a, unsigned int b, unsigned int c);  
   void link(unsigned int a, unsigned int b);                       
+  void syncCoords(unsigned int i);
+  void addConstraint(unsigned int u, unsigned int v);
+  bool eraseConstraint(unsigned int u, unsigned int v);
+
+  double coordX(unsigned int i) const { return coords[static_cast<size_t>(coordStride) * i]; }
+  double coordZ(unsigned int i) const { return coords[static_cast<size_t>(coordStride) * i + coordStride - 1]; }
 };
 
+static_assert(sizeof(Point3) == 3 * sizeof(double), "coordZ supone que Point3 son tres double seguidos");
+
 // OpenGL usa Y como altura vertical, por eso trabajamos en plano XZ
 // pero en código usamos nombres x, y por simplicidad
 
-Delaunay::Delaunay(const vector<Point3>& input) : points(input), hull_start(0) {
+Delaunay::Delaunay(const vector<Point3>& input, InsertionOrder order, CoordinateLayout layout)
+  : points(input), hull_start(0), layout(layout) {
+  build(order);
+}
+
+// Apunta coords a los puntos o a la copia compacta; el punto i se copia si es nuevo o cambió
+// (DynamicDelaunay), y si no se pasa ninguno se copian todos
+void Delaunay::syncCoords(unsigned int i) {
+  if (layout == POINTS) {
+    coords = points.empty() ? nullptr : &points[0].x;
+    coordStride = 3;
+    return;
+  }
+  unsigned int n = points.size();
+  unsigned int from = i == INVALID ? 0 : i;
+  compactCoords.resize(2 * static_cast<size_t>(n));
+  for (unsigned int k = from; k < n && (i == INVALID || k == i); k++) {
+    compactCoords[2 * static_cast<size_t>(k)] = points[k].x;
+    compactCoords[2 * static_cast<size_t>(k) + 1] = points[k].z;
+  }
+  coords = compactCoords.data();
+  coordStride = 2;
+}
+
+// Las restricciones se guardan dos veces: en `constraints` para que legalize las consulte en
+// O(1), y por vértice para que quitar un vértice no tenga que recorrerlas todas
+void Delaunay::addConstraint(unsigned int u, unsigned int v) {
+  if (!constraints.insert(edgeKey(min(u, v), max(u, v))).second) return;
+  constraintsAt[u].push_back(v);
+  constraintsAt[v].push_back(u);
+}
+
+bool Delaunay::eraseConstraint(unsigned int u, unsigned int v) {
+  if (!constraints.erase(edgeKey(min(u, v), max(u, v)))) return false;
+  for (auto [from, to] : {pair(u, v), pair(v, u)}) {
+    auto it = constraintsAt.find(from);
+    vector<unsigned int>& ends = it->second;
+    ends.erase(find(ends.begin(), ends.end(), to));
+    if (ends.empty()) constraintsAt.erase(it);
+  }
+  return true;
+}
+
+// Triangula todos los puntos desde cero
+void Delaunay::build(InsertionOrder order) {
+  triangles.clear();
+  halfedges.clear();
+  hull_prev.clear();
+  hull_next.clear();
+  hull_tri.clear();
+  hashTable.clear();
+  freeTriangles.clear();
+  hull_start = 0;
+  lastTri = 0;
   
   unsigned int n = points.size();
+  syncCoords(INVALID);
   if (n < 3) return;  // Mínimo 3 puntos para triangulación
+  DELAUNAY_START();
   
   double min_x = numeric_limits<double>::max();
   double min_y = numeric_limits<double>::max();
@@ -157,8 +644,8 @@ Delaunay::Delaunay(const vector<Point3>& input) : points(input), hull_start(0) {
 
   // Encontrar bounding box 
   for (unsigned int i = 0; i < n; i++) {
-    double x = points[i].x;
-    double y = points[i].z;
+    double x = coordX(i);
+    double y = coordZ(i);
     
     if (x < min_x) min_x = x;
     if (y < min_y) min_y = y;
@@ -168,6 +655,8 @@ Delaunay::Delaunay(const vector<Point3>& input) : points(input), hull_start(0) {
     ids.push_back(i);  
   }
   
+  DELAUNAY_LAP(bboxMs);
+
   // Centro del bounding box
   double cx = (min_x + max_x) / 2.0;
   double cy = (min_y + max_y) / 2.0;
@@ -178,24 +667,24 @@ Delaunay::Delaunay(const vector<Point3>& input) : points(input), hull_start(0) {
   double min_dist = numeric_limits<double>::max();
   
   for (unsigned int i = 0; i < n; i++) {
-    double d = distSq(points[i].x, points[i].z, cx, cy);
+    double d = distSq(coordX(i), coordZ(i), cx, cy);
     if (d < min_dist) {
       i0 = i;
       min_dist = d;
     }
   }
   
-  double i0x = points[i0].x;
-  double i0y = points[i0].z;
+  double i0x = coordX(i0);
+  double i0y = coordZ(i0);
   
   // i1: punto más cercano a i0 (y no coincidente)
   unsigned int i1 = INVALID;
   min_dist = numeric_limits<double>::max();
   
   for (unsigned int i = 0; i < n; i++) {
-    if (i == i0) continue;
-    double d = distSq(i0x, i0y, points[i].x, points[i].z);
-    if (d < min_dist && d > EPSILON) {
+    if (i == i0 || check_pts_equal(i0x, i0y, coordX(i), coordZ(i))) continue;
+    double d = distSq(i0x, i0y, coordX(i), coordZ(i));
+    if (d < min_dist) {
       i1 = i;
       min_dist = d;
     }
@@ -205,8 +694,8 @@ Delaunay::Delaunay(const vector<Point3>& input) : points(input), hull_start(0) {
     throw runtime_error("Puntos colineales o coincidentes");
   }
   
-  double i1x = points[i1].x;
-  double i1y = points[i1].z;
+  double i1x = coordX(i1);
+  double i1y = coordZ(i1);
   
   // i2: punto que forma el círculo circunscrito más pequeño con i0 e i1
   // Esto minimiza el radio del triángulo inicial
@@ -215,7 +704,8 @@ Delaunay::Delaunay(const vector<Point3>& input) : points(input), hull_start(0) {
   
   for (unsigned int i = 0; i < n; i++) {
     if (i == i0 || i == i1) continue;
-    double r = circumradius(i0x, i0y, i1x, i1y, points[i].x, points[i].z);
+    if (orient2d(i0x, i0y, i1x, i1y, coordX(i), coordZ(i)) == 0.0) continue;
+    double r = circumradius(i0x, i0y, i1x, i1y, coordX(i), coordZ(i));
     if (r < min_radius) {
       i2 = i;
       min_radius = r;
@@ -226,11 +716,11 @@ Delaunay::Delaunay(const vector<Point3>& input) : points(input), hull_start(0) {
     throw runtime_error("No se puede crear triangulación");
   }
   
-  double i2x = points[i2].x;
-  double i2y = points[i2].z;
+  double i2x = coordX(i2);
+  double i2y = coordZ(i2);
   
-  // Asegurar orientación CCW del triángulo inicial
-  if (!orient(i0x, i0y, i1x, i1y, i2x, i2y)) {
+  // Triángulo inicial en sentido horario (en x, z), como el resto de la malla
+  if (orient(i0x, i0y, i1x, i1y, i2x, i2y)) {
     swap(i1, i2);
     swap(i1x, i2x);
     swap(i1y, i2y);
@@ -247,9 +737,14 @@ Delaunay::Delaunay(const vector<Point3>& input) : points(input), hull_start(0) {
   
   circumCenter_x = i0x + (ey * bl - dy * cl) * 0.5 / d;
   circumCenter_y = i0y + (dx * cl - ex * bl) * 0.5 / d;
+  DELAUNAY_LAP(seedMs);
   
-  // Ordenar puntos por distancia radial al centro
-  sort(ids.begin(), ids.end(), compare(points, circumCenter_x, circumCenter_y));
+  if (order == BRIO) {
+    brioOrder(ids, min_x, min_y, max_x, max_y);
+  } else {
+    radialOrder(ids);
+  }
+  DELAUNAY_LAP(sortMs);
   
   // Inicializar estructuras de datos
   hashTableSize = static_cast<unsigned int>(ceil(sqrt(n)));
@@ -292,10 +787,19 @@ Delaunay::Delaunay(const vector<Point3>& input) : points(input), hull_start(0) {
   double xp = numeric_limits<double>::quiet_NaN();
   double yp = numeric_limits<double>::quiet_NaN();
   
+  if (order == BRIO) {
+    for (unsigned int k = 0; k < n; k++) {
+      unsigned int i = ids[k];
+      if (i != i0 && i != i1 && i != i2) insertPoint(i);
+    }
+    DELAUNAY_LAP(insertMs);
+    return;
+  }
+
   for (unsigned int k = 0; k < n; k++) {
     unsigned int i = ids[k];
-    double x = points[i].x;
-    double y = points[i].z;
+    double x = coordX(i);
+    double y = coordZ(i);
     
     // Saltar puntos duplicados (respecto a 2D no 3D)
     if (k > 0 && check_pts_equal(x, y, xp, yp)) {
@@ -313,7 +817,9 @@ Delaunay::Delaunay(const vector<Point3>& input) : points(input), hull_start(0) {
     unsigned int key = hashKey(x, y);
     
     // Sondeo lineal para manejar colisiones
+    DELAUNAY_COUNT(hashLookups);
     for (unsigned int j = 0; j < hashTableSize; j++) {
+      DELAUNAY_COUNT(hashProbes);
       start = hashTable[fast_mod(key + j, hashTableSize)];
       if (start != INVALID && start != hull_next[start]) break;
     }
@@ -323,9 +829,11 @@ Delaunay::Delaunay(const vector<Point3>& input) : points(input), hull_start(0) {
     unsigned int q;
     
     // Buscar primera arista del envolvente visible desde el punto P
+    DELAUNAY_COUNT(hullWalks);
     while (true) {
+      DELAUNAY_COUNT(hullWalkSteps);
       q = hull_next[e];  
-      if (orient(x, y, points[e].x, points[e].z, points[q].x, points[q].z)) {
+      if (orient(x, y, coordX(e), coordZ(e), coordX(q), coordZ(q))) {
         break;
       }
       e = q;
@@ -335,56 +843,304 @@ Delaunay::Delaunay(const vector<Point3>& input) : points(input), hull_start(0) {
       }
     }
     
-    if (e == INVALID) continue;  
-    
-    // Crear primer triángulo conectando P a la arista visible
-    unsigned int t = addTriangle(e, i, hull_next[e], INVALID, INVALID, hull_tri[e]);
-    
-    // Legalizar la nueva arista p-q
-    hull_tri[i] = legalize(t + 2);  
-    hull_tri[e] = t; 
-    
-    // Extender en sentido antihorario mientras sea visible
-    unsigned int next = hull_next[e];
+    // Ninguna arista visible: el punto no quedó fuera de la envolvente (por ejemplo, adentro del
+    // triángulo inicial). Se inserta como en BRIO en lugar de perderlo.
+    if (e == INVALID) insertPoint(i);
+    else insertOutside(i, e);
+  }
+  DELAUNAY_LAP(insertMs);
+}
+
+// Agrega el punto i, que está fuera de la envolvente y ve la arista e -> hull_next[e].
+// Cubre con triángulos todas las aristas visibles desde i, hacia adelante y, si walkBack,
+// también hacia atrás desde e. Las aristas colineales con i no cuentan como visibles: el
+// triángulo sería plano.
+void Delaunay::addHullPoint(unsigned int i, unsigned int e, bool walkBack) {
+  double x = coordX(i);
+  double y = coordZ(i);
+  unsigned int q;
+  auto visible = [&](unsigned int a, unsigned int b) {
+    return orient2d(x, y, coordX(a), coordZ(a), coordX(b), coordZ(b)) > 0.0;
+  };
+
+  // Crear primer triángulo conectando P a la arista visible
+  unsigned int t = addTriangle(e, i, hull_next[e], INVALID, INVALID, hull_tri[e]);
+  
+  // Legalizar la nueva arista p-q
+  hull_tri[i] = legalize(t + 2);  
+  hull_tri[e] = t; 
+  
+  // Extender en sentido antihorario mientras sea visible
+  unsigned int next = hull_next[e];
+  while (true) {
+    q = hull_next[next];
+    if (!visible(next, q)) {
+      break; 
+    }
+    // Crear triángulo (next, P, q)
+    DELAUNAY_COUNT(hullExtendSteps);
+    t = addTriangle(next, i, q, hull_tri[i], INVALID, hull_tri[next]);
+    hull_tri[i] = legalize(t + 2);
+    hull_next[next] = next;  
+    next = q;  
+  }
+  
+  // Extender en sentido horario si es necesario
+  if (walkBack) {
     while (true) {
-      q = hull_next[next];
-      if (!orient(x, y, points[next].x, points[next].z, points[q].x, points[q].z)) {
-        break; 
+      q = hull_prev[e];
+      if (!visible(q, e)) {
+        break;
       }
-      // Crear triángulo (next, P, q)
-      t = addTriangle(next, i, q, hull_tri[i], INVALID, hull_tri[next]);
-      hull_tri[i] = legalize(t + 2);
-      hull_next[next] = next;  
-      next = q;  
+      // Crear triángulo (q, P, e)
+      DELAUNAY_COUNT(hullExtendSteps);
+      t = addTriangle(q, i, e, INVALID, hull_tri[e], hull_tri[q]);
+      legalize(t + 2);
+      hull_tri[q] = t;
+      hull_next[e] = e;
+      e = q;
     }
-    
-    // Extender en sentido horario si es necesario
-    if (e == start) {
-      while (true) {
-        q = hull_prev[e];
-        if (!orient(x, y, points[q].x, points[q].z, points[e].x, points[e].z)) {
-          break;
-        }
-        // Crear triángulo (q, P, e)
-        t = addTriangle(q, i, e, INVALID, hull_tri[e], hull_tri[q]);
-        legalize(t + 2);
-        hull_tri[q] = t;
-        hull_next[e] = e;
-        e = q;
+  }
+  
+  // Actualizar envolvente convexa
+  hull_prev[i] = e;
+  hull_start = e;
+  hull_prev[next] = i;
+  hull_next[e] = i;
+  hull_next[i] = next;
+  
+  // Actualizar tabla hash con nuevos vértices dla envolvente
+  hashTable[hashKey(x, y)] = i;
+  hashTable[hashKey(coordX(e), coordZ(e))] = e;
+  lastTri = t / 3;
+}
+
+// Ordena los puntos por distancia al centro del triángulo inicial. La distancia se calcula
+// una vez por punto; los empates exactos se desempatan por x, luego z y luego índice, así los
+// puntos repetidos quedan juntos y el orden no depende del algoritmo de ordenamiento.
+void Delaunay::radialOrder(vector<unsigned int>& ids) {
+  unsigned int n = ids.size();
+  vector<SortKey> keys(n);
+  forChunks(n, sortThreads(n), [&](unsigned int lo, unsigned int hi, unsigned int) {
+    for (unsigned int k = lo; k < hi; k++) {
+      unsigned int i = ids[k];
+      keys[k] = {orderedBits(distSq(coordX(i), coordZ(i), circumCenter_x, circumCenter_y)), i};
+    }
+  });
+  sortKeys(keys);
+
+  for (unsigned int k = 0, run; k < n; k = run) {
+    run = k + 1;
+    while (run < n && keys[run].first == keys[k].first) run++;
+    if (run - k > 1) {
+      sort(keys.begin() + k, keys.begin() + run, [&](const SortKey& a, const SortKey& b) {
+        const Point3& p = points[a.second];
+        const Point3& q = points[b.second];
+        if (p.x != q.x) return p.x < q.x;
+        if (p.z != q.z) return p.z < q.z;
+        return a.second < b.second;
+      });
+    }
+  }
+  for (unsigned int k = 0; k < n; k++) ids[k] = keys[k].second;
+}
+
+// Orden BRIO: cada punto cae en la última ronda con probabilidad 1/2, en la penúltima con 1/4,
+// etc. Las rondas van de la más chica a la más grande y dentro de cada una se sigue la curva de
+// Hilbert. La ronda sale de un hash de las coordenadas y no de un generador: es reproducible y
+// los puntos repetidos quedan en la misma ronda y con la misma llave, así que (como el
+// ordenamiento es estable) se inserta primero el de menor índice y ese es el que se queda, igual
+// que en el orden radial.
+void Delaunay::brioOrder(vector<unsigned int>& ids, double min_x, double min_y, double max_x, double max_y) {
+  const unsigned int ROUNDS = 32;
+  double sx = max_x > min_x ? 65535.0 / (max_x - min_x) : 0.0;
+  double sy = max_y > min_y ? 65535.0 / (max_y - min_y) : 0.0;
+
+  vector<SortKey> keys(ids.size());
+  for (unsigned int k = 0; k < ids.size(); k++) {
+    unsigned int i = ids[k];
+    // + 0.0 para que -0.0 y 0.0, que son el mismo punto, den el mismo hash
+    unsigned int level = min(ROUNDS - 1, static_cast<unsigned int>(
+        countr_one(mixBits(orderedBits(coordX(i) + 0.0) ^ (orderedBits(coordZ(i) + 0.0) * 0x9e3779b97f4a7c15ull)))));
+    unsigned int hx = static_cast<unsigned int>((coordX(i) - min_x) * sx);
+    unsigned int hy = static_cast<unsigned int>((coordZ(i) - min_y) * sy);
+    unsigned long long round = ROUNDS - 1 - level;
+    keys[k] = {(round << 32) | hilbertIndex(hx, hy), i};
+  }
+  sortKeys(keys);
+  for (unsigned int k = 0; k < ids.size(); k++) ids[k] = keys[k].second;
+}
+
+// Parte la arista e = a -> b, con triángulos (a, b, c) y (b, a, d), en cuatro triángulos
+// alrededor de P: (a, P, c), (P, b, c), (b, P, d) y (P, a, d). Si e es de la envolvente solo
+// hay los dos primeros y P entra a la envolvente entre a y b.
+void Delaunay::splitEdge(unsigned int i, unsigned int e) {
+  unsigned int t = 3 * (e / 3);
+  unsigned int e1 = t + (e - t + 1) % 3;
+  unsigned int e2 = t + (e - t + 2) % 3;
+  unsigned int tw = halfedges[e];
+  unsigned int a = triangles[e], b = triangles[e1], c = triangles[e2];
+
+  unsigned int hb = halfedges[e1];
+  triangles[e1] = i;
+  unsigned int t3 = addTriangle(i, b, c, tw, hb, e1);
+  if (hb == INVALID) hull_tri[b] = t3 + 1;
+  // Una restricción partida sigue siendo restricción en sus dos mitades
+  if (!constraints.empty() && eraseConstraint(a, b)) {
+    addConstraint(a, i);
+    addConstraint(i, b);
+  }
+
+  if (tw == INVALID) {
+    hull_next[a] = i;
+    hull_prev[i] = a;
+    hull_next[i] = b;
+    hull_prev[b] = i;
+    hull_tri[a] = e;
+    hull_tri[i] = t3;
+    hashTable[hashKey(coordX(i), coordZ(i))] = i;
+    legalize(e2);
+    legalize(t3 + 1);
+    lastTri = t / 3;
+    return;
+  }
+
+  unsigned int u = 3 * (tw / 3);
+  unsigned int f1 = u + (tw - u + 1) % 3;
+  unsigned int f2 = u + (tw - u + 2) % 3;
+  unsigned int d = triangles[f2];
+  unsigned int hf = halfedges[f1];
+  triangles[f1] = i;
+  unsigned int t4 = addTriangle(i, a, d, e, hf, f1);
+  if (hf == INVALID) hull_tri[a] = t4 + 1;
+
+  legalize(e2);
+  legalize(t3 + 1);
+  legalize(f2);
+  legalize(t4 + 1);
+  lastTri = t / 3;
+}
+
+// Camina desde lastTri hacia (x, y) cruzando cada vez una arista que deja al punto del otro
+// lado. Regresa el primer halfedge del triángulo que contiene al punto o, si outside, el
+// halfedge de la envolvente por el que el punto queda afuera.
+unsigned int Delaunay::locate(double x, double y, bool& outside) {
+  unsigned int t = 3 * lastTri;
+  unsigned int rot = 0;
+  unsigned int maxSteps = triangles.size();
+  outside = false;
+  DELAUNAY_COUNT(locates);
+
+  for (unsigned int step = 0; step <= maxSteps; step++) {
+    DELAUNAY_COUNT(locateSteps);
+    bool moved = false;
+    for (unsigned int j = 0; j < 3 && !moved; j++) {
+      // Empezar por una arista distinta cada vez evita ciclos con puntos degenerados
+      unsigned int e = t + (j + rot) % 3;
+      unsigned int a = triangles[e];
+      unsigned int b = triangles[t + (e - t + 1) % 3];
+      double c = orient2d(coordX(a), coordZ(a), coordX(b), coordZ(b), x, y);
+      // Sobre la recta de una arista de la envolvente cuenta como afuera; insertPoint la parte
+      // o sigue por la envolvente. Con tolerancia, un punto apenas adentro no vería ninguna arista.
+      if (halfedges[e] == INVALID && c >= 0.0) {
+        outside = true;
+        return e;
       }
+      if (c <= 0.0) continue;
+      t = 3 * (halfedges[e] / 3);
+      moved = true;
     }
-    
-    // Actualizar envolvente convexa
-    hull_prev[i] = e;
-    hull_start = e;
-    hull_prev[next] = i;
-    hull_next[e] = i;
-    hull_next[i] = next;
-    
-    // Actualizar tabla hash con nuevos vértices dla envolvente
-    hashTable[hashKey(x, y)] = i;
-    hashTable[hashKey(points[e].x, points[e].z)] = e;
+    if (!moved) return t;
+    rot++;
   }
+
+  // La caminata no terminó (no debería pasar): buscar en todos los triángulos
+  for (t = 0; t < triangles.size(); t += 3) {
+    if (triangles[t] == INVALID) continue;  // Borrado
+    bool inside = true;
+    for (unsigned int j = 0; j < 3 && inside; j++) {
+      unsigned int a = triangles[t + j];
+      unsigned int b = triangles[t + (j + 1) % 3];
+      if (orient2d(coordX(a), coordZ(a), coordX(b), coordZ(b), x, y) > 0.0) inside = false;
+    }
+    if (inside) return t;
+  }
+  return t - 3;
+}
+
+// Agrega el punto i, que está fuera de la envolvente o sobre la recta de su arista
+// a -> hull_next[a]. Regresa falso si ya había un punto en la misma posición.
+bool Delaunay::insertOutside(unsigned int i, unsigned int a) {
+  double x = coordX(i);
+  double y = coordZ(i);
+  // Saltar duplicados de los extremos de la arista
+  unsigned int b = hull_next[a];
+  if (check_pts_equal(x, y, coordX(a), coordZ(a)) || check_pts_equal(x, y, coordX(b), coordZ(b))) return false;
+  // Exactamente sobre la recta de la arista: si cae en ella se parte, si no se avanza por la
+  // envolvente hasta una arista que se vea de verdad. Así no quedan triángulos planos.
+  double dir = 0.0;
+  while (orient2d(coordX(a), coordZ(a), coordX(b), coordZ(b), x, y) == 0.0) {
+    double dx = coordX(b) - coordX(a), dy = coordZ(b) - coordZ(a);
+    double dot = (x - coordX(a)) * dx + (y - coordZ(a)) * dy;
+    if (dot > 0 && dot < dx * dx + dy * dy) {
+      splitEdge(i, hull_tri[a]);
+      return true;
+    }
+    if (dir == 0.0) dir = dot;
+    a = dir > 0 ? b : hull_prev[a];
+    b = hull_next[a];
+    if (check_pts_equal(x, y, coordX(a), coordZ(a)) || check_pts_equal(x, y, coordX(b), coordZ(b))) return false;
+  }
+  addHullPoint(i, a, true);
+  return true;
+}
+
+// Inserta el punto i localizándolo con una caminata (modo BRIO). Regresa falso si ya había
+// un punto en la misma posición.
+bool Delaunay::insertPoint(unsigned int i) {
+  double x = coordX(i);
+  double y = coordZ(i);
+  bool outside;
+  unsigned int t = locate(x, y, outside);
+
+  if (outside) return insertOutside(i, triangles[t]);
+
+  unsigned int a = triangles[t];
+  unsigned int b = triangles[t + 1];
+  unsigned int c = triangles[t + 2];
+  // Saltar puntos duplicados
+  if (check_pts_equal(x, y, coordX(a), coordZ(a)) ||
+      check_pts_equal(x, y, coordX(b), coordZ(b)) ||
+      check_pts_equal(x, y, coordX(c), coordZ(c))) {
+    return false;
+  }
+
+  // Exactamente sobre una arista interior: partirla, si no quedaría un triángulo plano que
+  // legalize no siempre quita
+  for (unsigned int j = 0; j < 3; j++) {
+    unsigned int p = triangles[t + j], q = triangles[t + (j + 1) % 3];
+    if (orient2d(coordX(p), coordZ(p), coordX(q), coordZ(q), x, y) == 0.0) {
+      splitEdge(i, t + j);
+      return true;
+    }
+  }
+
+  // Partir (a, b, c) en (a, b, P), (b, c, P) y (c, a, P)
+  unsigned int hb = halfedges[t + 1];
+  unsigned int hc = halfedges[t + 2];
+  triangles[t + 2] = i;
+  unsigned int t1 = addTriangle(b, c, i, hb, INVALID, t + 1);
+  unsigned int t2 = addTriangle(c, a, i, hc, t + 2, t1 + 1);
+
+  // Las aristas de la envolvente que cambiaron de triángulo
+  if (hb == INVALID) hull_tri[b] = t1;
+  if (hc == INVALID) hull_tri[c] = t2;
+
+  legalize(t);
+  legalize(t1);
+  legalize(t2);
+  lastTri = t / 3;
+  return true;
 }
 
 double Delaunay::getHullArea() {
@@ -392,7 +1148,7 @@ double Delaunay::getHullArea() {
   unsigned int e = hull_start;
   
   do {
-    double area = (points[e].x - points[hull_prev[e]].x) * (points[e].z + points[hull_prev[e]].z);
+    double area = (coordX(e) - coordX(hull_prev[e])) * (coordZ(e) + coordZ(hull_prev[e]));
     hull_area.push_back(area);
     e = hull_next[e];
   } while (e != hull_start);
@@ -407,6 +1163,7 @@ unsigned int Delaunay::legalize(unsigned int a) {
   unsigned int i = 0;           
   unsigned int ar = 0;
   illegalEdgeStack.clear();
+  DELAUNAY_COUNT(legalizeCalls);
   
   while (true) {
     unsigned int b = halfedges[a]; 
@@ -436,32 +1193,45 @@ unsigned int Delaunay::legalize(unsigned int a) {
     unsigned int pl = triangles[al];  
     unsigned int p1 = triangles[bl];
     
-    // Prueba de la circunferencia
+    // Prueba de la circunferencia, con los empates rotos por índice
     bool illegal = InCircle(
-      points[p0].x, points[p0].z,
-      points[pr].x, points[pr].z,
-      points[pl].x, points[pl].z,
-      points[p1].x, points[p1].z);
+      coordX(p0), coordZ(p0),
+      coordX(pr), coordZ(pr),
+      coordX(pl), coordZ(pl),
+      coordX(p1), coordZ(p1),
+      p0, pr, pl, p1);
+    // Las aristas restringidas no se voltean
+    if (illegal && !constraints.empty() && constraints.count(edgeKey(min(pr, pl), max(pr, pl)))) {
+      illegal = false;
+    }
     
     if (illegal) {
       // Flipping de la arista
+      DELAUNAY_COUNT(flips);
       triangles[a] = p1;
       triangles[b] = p0;
       
       // Actualizar referencias de aristas
       unsigned int hbl = halfedges[bl];
       
-      // Si bl estaba en la envolvente, actualizar su triángulo incidente
+      // Si bl estaba en la envolvente, actualizar su triángulo incidente. Se recorre con
+      // hull_prev: a media addHullPoint los vértices que salen de la envolvente ya tienen
+      // hull_next apuntando a sí mismos y hull_prev todavía no cambió
       if (hbl == INVALID) {
+        DELAUNAY_COUNT(hullRescans);
         unsigned int e = hull_start;
         do {
+          DELAUNAY_COUNT(hullRescanSteps);
           if (hull_tri[e] == bl) {
             hull_tri[e] = a;
             break;
           }
-          e = hull_next[e];
+          e = hull_prev[e];
         } while (e != hull_start);
       }
+      // Igual con ar (p0 -> pr), que pasa a ser b; solo está en la envolvente cuando
+      // splitEdge partió una arista de la envolvente
+      if (halfedges[ar] == INVALID && hull_tri[p0] == ar) hull_tri[p0] = b;
       
       // Re-enlazar todas las aristas afectadas
       link(a, hbl);
@@ -477,6 +1247,7 @@ unsigned int Delaunay::legalize(unsigned int a) {
         illegalEdgeStack.push_back(br);
       }
       i++;
+      DELAUNAY_MAX(maxStackDepth, i);
     } else {
       if (i > 0) {
         i--;
@@ -501,10 +1272,19 @@ unsigned int Delaunay::hashKey(double x, double y) const {
 }
 
 unsigned int Delaunay::addTriangle(unsigned int i0, unsigned int i1, unsigned int i2, unsigned int a, unsigned int b, unsigned int c) {
-  unsigned int t = triangles.size();  
-  triangles.push_back(i0);
-  triangles.push_back(i1);
-  triangles.push_back(i2);
+  unsigned int t;
+  if (freeTriangles.empty()) {
+    t = triangles.size();  
+    triangles.push_back(i0);
+    triangles.push_back(i1);
+    triangles.push_back(i2);
+  } else {
+    t = 3 * freeTriangles.back();
+    freeTriangles.pop_back();
+    triangles[t] = i0;
+    triangles[t + 1] = i1;
+    triangles[t + 2] = i2;
+  }
   
   // Enlazar cada arista con su twin
   link(t, a);      
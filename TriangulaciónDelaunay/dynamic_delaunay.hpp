@@ -0,0 +1,339 @@
+#ifndef DYNAMIC_DELAUNAY_H
+#define DYNAMIC_DELAUNAY_H
+
+#include "delaunay.hpp"
+#include <array>
+#include <unordered_map>
+
+using namespace std;
+
+// Dueño de los puntos; va antes que Delaunay en la lista de bases para que `points`
+// apunte a un vector que ya existe
+struct DelaunayPoints {
+  vector<Point3> store;
+};
+
+// Triangulación de Delaunay que se puede editar: insert agrega un punto localizándolo con una
+// caminata y legalizando, remove quita un vértice y vuelve a triangular el hueco. Ambos
+// trabajan sobre triangles/halfedges en su lugar; los triángulos borrados quedan con
+// triangles[3t] == INVALID hasta que addTriangle los reutiliza. compact() los quita, por
+// ejemplo antes de mandar los índices a dibujar.
+class DynamicDelaunay : private DelaunayPoints, public Delaunay {
+public:
+  DynamicDelaunay(const vector<Point3>& input, InsertionOrder order = BRIO, CoordinateLayout layout = POINTS);
+  // `points` apunta a los puntos propios, una copia apuntaría a los del original
+  DynamicDelaunay(const DynamicDelaunay&) = delete;
+  DynamicDelaunay& operator=(const DynamicDelaunay&) = delete;
+
+  // Regresa el índice del nuevo vértice, o INVALID si ya había un punto en esa posición
+  unsigned int insert(const Point3& p);
+  void remove(unsigned int v);
+  // Mover = quitar y volver a insertar; regresa el nuevo índice como insert
+  unsigned int move(unsigned int v, const Point3& p);
+
+  bool alive(unsigned int t) const { return triangles[3 * t] != INVALID; }
+  unsigned int triangleCount() const { return triangles.size() / 3 - freeTriangles.size(); }
+  void compact();
+
+protected:
+  vector<unsigned int> freeVertices;  // Índices de vértices quitados, para reutilizarlos
+
+  unsigned int findEdge(unsigned int v);
+  void restoreDelaunay(vector<unsigned int> stack);
+};
+
+DynamicDelaunay::DynamicDelaunay(const vector<Point3>& input, InsertionOrder order, CoordinateLayout layout)
+  : DelaunayPoints{input}, Delaunay(store, order, layout) {}
+
+unsigned int DynamicDelaunay::insert(const Point3& p) {
+  unsigned int i;
+  if (!freeVertices.empty()) {
+    i = freeVertices.back();
+    freeVertices.pop_back();
+    store[i] = p;
+  } else {
+    i = store.size();
+    store.push_back(p);
+    hull_prev.push_back(INVALID);
+    hull_next.push_back(INVALID);
+    hull_tri.push_back(INVALID);
+  }
+  syncCoords(i);
+
+  if (triangles.empty()) {
+    // Todavía no hay triangulación (menos de 3 puntos o todos colineales): empezar de nuevo
+    try {
+      build(RADIAL);
+    } catch (const runtime_error&) {
+      triangles.clear();
+      halfedges.clear();
+    }
+    return i;
+  }
+
+  if (!insertPoint(i)) {
+    freeVertices.push_back(i);
+    return INVALID;
+  }
+  return i;
+}
+
+// Un halfedge que sale de v, o INVALID si v no está en la triangulación
+unsigned int DynamicDelaunay::findEdge(unsigned int v) {
+  bool outside;
+  unsigned int e = locate(coordX(v), coordZ(v), outside);
+  unsigned int t = 3 * (e / 3);
+  for (unsigned int j = 0; j < 3; j++) {
+    if (triangles[t + j] == v) return t + j;
+  }
+  // Con puntos degenerados la caminata puede terminar al lado: buscar en todos
+  for (e = 0; e < triangles.size(); e++) {
+    if (triangles[e] == v) return e;
+  }
+  return INVALID;
+}
+
+// Quita v y llena el hueco con orejas: (a, b, c) consecutivos en el borde del hueco es oreja
+// si gira hacia adentro y su círculo no tiene a otro vértice del borde. Esa oreja es un
+// triángulo de Delaunay de lo que queda, así que no hace falta legalizar (salvo junto a
+// restricciones, ver abajo).
+void DynamicDelaunay::remove(unsigned int v) {
+  if (v >= store.size()) throw runtime_error("remove: vértice fuera de rango");
+  unsigned int start = findEdge(v);
+  if (start == INVALID) throw runtime_error("remove: el vértice no está en la triangulación");
+
+  // Retroceder hasta la arista de la envolvente si v está en ella
+  unsigned int e = start;
+  bool onHull = false;
+  while (true) {
+    if (halfedges[e] == INVALID) {
+      onHull = true;
+      break;
+    }
+    e = nextHalfedge(halfedges[e]);
+    if (e == start) break;
+  }
+
+  // Borde del hueco (los vecinos de v en orden) y, por cada arista del borde, el halfedge de
+  // afuera con el que se enlaza. outer[k] va de poly[k+1] a poly[k].
+  vector<unsigned int> ring, poly, outer;
+  unsigned int first = e;
+  do {
+    ring.push_back(e);
+    unsigned int n1 = nextHalfedge(e);
+    poly.push_back(triangles[n1]);
+    outer.push_back(halfedges[n1]);
+    e = halfedges[prevHalfedge(e)];
+  } while (e != INVALID && e != first && ring.size() <= triangles.size());
+  if (onHull) {
+    // El último vértice de la cadena no tiene arista siguiente
+    poly.push_back(triangles[prevHalfedge(ring.back())]);
+    outer.push_back(INVALID);
+  }
+
+  auto convex = [&](unsigned int a, unsigned int b, unsigned int c) {
+    unsigned int pa = poly[a], pb = poly[b], pc = poly[c];
+    return !orient(coordX(pa), coordZ(pa), coordX(pb), coordZ(pb), coordX(pc), coordZ(pc));
+  };
+  // Posiciones que quedan en el borde; en la envolvente es una cadena abierta
+  vector<unsigned int> idx(poly.size());
+  for (unsigned int k = 0; k < poly.size(); k++) idx[k] = k;
+  auto ear = [&](unsigned int a, unsigned int b, unsigned int c) {
+    if (!convex(a, b, c)) return false;
+    unsigned int pa = poly[a], pb = poly[b], pc = poly[c];
+    for (unsigned int k : idx) {
+      if (k == a || k == b || k == c) continue;
+      unsigned int q = poly[k];
+      if (InCircle(coordX(pa), coordZ(pa), coordX(pb), coordZ(pb), coordX(pc), coordZ(pc),
+                   coordX(q), coordZ(q), pa, pb, pc, q)) return false;
+    }
+    return true;
+  };
+
+  // En la envolvente, si todos los triángulos tocan a v y la cadena no tiene orejas no queda nada
+  if (onHull && ring.size() == triangleCount()) {
+    bool any = false;
+    for (unsigned int k = 0; k + 2 < poly.size() && !any; k++) any = convex(k, k + 1, k + 2);
+    if (!any) throw runtime_error("remove: la triangulación quedaría vacía");
+  }
+
+  for (unsigned int r : ring) {
+    unsigned int t = 3 * (r / 3);
+    for (unsigned int j = 0; j < 3; j++) {
+      triangles[t + j] = INVALID;
+      halfedges[t + j] = INVALID;
+    }
+    freeTriangles.push_back(t / 3);
+  }
+
+  // Primero se escogen las orejas, como posiciones de poly, y después se crean los triángulos.
+  // Con restricciones alrededor el hueco no tiene por qué ser de Delaunay y puede no haber
+  // oreja de Delaunay: entonces se toma una oreja convexa sin vértices del borde adentro y al
+  // final se voltean las aristas que no queden de Delaunay
+  auto inside = [&](unsigned int a, unsigned int b, unsigned int c, unsigned int k) {
+    unsigned int pa = poly[a], pb = poly[b], pc = poly[c], q = poly[k];
+    return orient2d(coordX(pa), coordZ(pa), coordX(pb), coordZ(pb), coordX(q), coordZ(q)) <= 0.0 &&
+           orient2d(coordX(pb), coordZ(pb), coordX(pc), coordZ(pc), coordX(q), coordZ(q)) <= 0.0 &&
+           orient2d(coordX(pc), coordZ(pc), coordX(pa), coordZ(pa), coordX(q), coordZ(q)) <= 0.0;
+  };
+  auto emptyEar = [&](unsigned int a, unsigned int b, unsigned int c) {
+    if (!convex(a, b, c)) return false;
+    for (unsigned int k : idx) {
+      if (k != a && k != b && k != c && inside(a, b, c, k)) return false;
+    }
+    return true;
+  };
+
+  vector<array<unsigned int, 3>> fill;
+  // Quitar las restricciones de v deja ver puntos que tapaban, también desde afuera del hueco
+  bool needFlips = constraintsAt.count(v) > 0;
+  while (true) {
+    unsigned int m = idx.size();
+    if (!onHull && m == 3) {
+      fill.push_back({idx[0], idx[1], idx[2]});
+      break;
+    }
+    if (m < 3) break;
+
+    unsigned int limit = onHull ? m - 2 : m;
+    unsigned int found = INVALID;
+    for (unsigned int j = 0; j < limit && found == INVALID; j++) {
+      if (ear(idx[j], idx[(j + 1) % m], idx[(j + 2) % m])) found = j;
+    }
+    for (unsigned int j = 0; j < limit && found == INVALID; j++) {
+      if (emptyEar(idx[j], idx[(j + 1) % m], idx[(j + 2) % m])) found = j;
+    }
+    // En la envolvente, cuando ya no hay orejas la cadena que queda es convexa
+    if (found == INVALID) break;
+    if (!ear(idx[found], idx[(found + 1) % m], idx[(found + 2) % m])) needFlips = true;
+
+    fill.push_back({idx[found], idx[(found + 1) % m], idx[(found + 2) % m]});
+    idx.erase(idx.begin() + (found + 1) % m);
+  }
+
+  // Las aristas entre posiciones seguidas son del borde y se enlazan con outer; las demás son
+  // diagonales y se enlazan entre sí. Las del borde que ya eran de la envolvente cambian de
+  // triángulo.
+  unsigned int n = poly.size();
+  auto onBorder = [&](unsigned int p, unsigned int q) {
+    return q == p + 1 || (!onHull && p == n - 1 && q == 0);
+  };
+  unordered_map<unsigned long long, unsigned int> diagonal;
+  auto twin = [&](unsigned int p, unsigned int q) {
+    if (onBorder(p, q)) return outer[p];
+    auto it = diagonal.find(edgeKey(q, p));
+    return it == diagonal.end() ? INVALID : it->second;
+  };
+  unsigned int lastNew = INVALID;
+  vector<unsigned int> added;
+  for (auto& f : fill) {
+    unsigned int t = addTriangle(poly[f[0]], poly[f[1]], poly[f[2]], twin(f[0], f[1]), twin(f[1], f[2]), twin(f[2], f[0]));
+    for (unsigned int j = 0; j < 3; j++) {
+      unsigned int p = f[j], q = f[(j + 1) % 3];
+      if (!onBorder(p, q)) diagonal[edgeKey(p, q)] = t + j;
+      else if (outer[p] == INVALID) hull_tri[poly[p]] = t + j;
+    }
+    lastNew = t / 3;
+    for (unsigned int j = 0; j < 3; j++) added.push_back(t + j);
+  }
+  // En la envolvente, las diagonales que quedaron en la cadena dan hacia afuera
+  for (unsigned int k = 0; onHull && k + 1 < idx.size(); k++) {
+    if (!onBorder(idx[k], idx[k + 1])) outer[idx[k]] = diagonal[edgeKey(idx[k + 1], idx[k])];
+  }
+
+  if (onHull) {
+    // La cadena que quedó reemplaza a v en la envolvente, recorrida al revés
+    for (unsigned int k = 0; k + 1 < idx.size(); k++) {
+      unsigned int a = poly[idx[k]], b = poly[idx[k + 1]];
+      unsigned int h = outer[idx[k]];
+      if (h != INVALID) halfedges[h] = INVALID;
+      hull_next[b] = a;
+      hull_prev[a] = b;
+      hull_tri[b] = h;
+    }
+    if (hull_start == v) hull_start = poly[0];
+  }
+
+  // La siguiente caminata empieza en un triángulo vivo
+  if (lastNew != INVALID) lastTri = lastNew;
+  else {
+    for (unsigned int k : idx) if (outer[k] != INVALID) lastTri = outer[k] / 3;
+  }
+  hull_prev[v] = hull_next[v] = hull_tri[v] = INVALID;
+  freeVertices.push_back(v);
+
+  // Las restricciones que llegaban a v se van con él
+  auto it = constraintsAt.find(v);
+  if (it != constraintsAt.end()) {
+    vector<unsigned int> ends = it->second;
+    for (unsigned int w : ends) eraseConstraint(v, w);
+  }
+  if (needFlips) restoreDelaunay(added);
+}
+
+// Lawson: voltea las aristas que no son de Delaunay (y no están restringidas) empezando por
+// las de stack; después de cada vuelta revisa las cuatro aristas de afuera del cuadrilátero.
+// Solo cambian aristas que dejaron de ser de Delaunay, así que el trabajo es local.
+void DynamicDelaunay::restoreDelaunay(vector<unsigned int> stack) {
+  while (!stack.empty()) {
+    unsigned int a = stack.back();
+    stack.pop_back();
+    unsigned int b = halfedges[a];
+    if (b == INVALID || triangles[a] == INVALID) continue;
+
+    // Mismos nombres que en legalize
+    unsigned int a0 = 3 * (a / 3), b0 = 3 * (b / 3);
+    unsigned int al = a0 + (a + 1) % 3, ar = a0 + (a + 2) % 3;
+    unsigned int bl = b0 + (b + 2) % 3, br = b0 + (b + 1) % 3;
+    unsigned int p0 = triangles[ar], pr = triangles[a], pl = triangles[al], p1 = triangles[bl];
+    if (!constraints.empty() && constraints.count(edgeKey(min(pr, pl), max(pr, pl)))) continue;
+    if (!InCircle(coordX(p0), coordZ(p0), coordX(pr), coordZ(pr), coordX(pl), coordZ(pl),
+                  coordX(p1), coordZ(p1), p0, pr, pl, p1)) continue;
+
+    triangles[a] = p1;
+    triangles[b] = p0;
+    unsigned int hbl = halfedges[bl], har = halfedges[ar];
+    if (hbl == INVALID && hull_tri[p1] == bl) hull_tri[p1] = a;
+    if (har == INVALID && hull_tri[p0] == ar) hull_tri[p0] = b;
+    link(a, hbl);
+    link(b, har);
+    link(ar, bl);
+    stack.insert(stack.end(), {a, al, b, br});
+  }
+}
+
+unsigned int DynamicDelaunay::move(unsigned int v, const Point3& p) {
+  remove(v);
+  return insert(p);
+}
+
+// Quita los triángulos borrados y renumera los halfedges
+void DynamicDelaunay::compact() {
+  if (freeTriangles.empty()) return;
+  unsigned int m = triangles.size() / 3;
+  vector<unsigned int> newIndex(m, INVALID);
+  unsigned int next = 0;
+  for (unsigned int t = 0; t < m; t++) if (alive(t)) newIndex[t] = next++;
+
+  for (unsigned int t = 0; t < m; t++) {
+    if (newIndex[t] == INVALID) continue;
+    for (unsigned int j = 0; j < 3; j++) {
+      unsigned int e = 3 * t + j, o = 3 * newIndex[t] + j;
+      unsigned int h = halfedges[e];
+      triangles[o] = triangles[e];
+      halfedges[o] = h == INVALID ? INVALID : 3 * newIndex[h / 3] + h % 3;
+    }
+  }
+  triangles.resize(3 * next);
+  halfedges.resize(3 * next);
+  // Solo los vértices de la envolvente tienen hull_tri al día
+  unsigned int e = hull_start;
+  do {
+    hull_tri[e] = 3 * newIndex[hull_tri[e] / 3] + hull_tri[e] % 3;
+    e = hull_next[e];
+  } while (e != hull_start);
+  lastTri = newIndex[lastTri] == INVALID ? 0 : newIndex[lastTri];
+  freeTriangles.clear();
+}
+
+#endif
@@ -0,0 +1,277 @@
+#ifndef LOD_H
+#define LOD_H
+
+#include "dynamic_delaunay.hpp"
+#include "point_location.hpp"
+#include <queue>
+#include <unordered_map>
+
+using namespace std;
+
+// Niveles de detalle de un terreno (la altura es Point3::y) por inserción voraz: se empieza con
+// las esquinas de la envolvente y se inserta siempre el punto con mayor error vertical respecto
+// a la malla actual, hasta que ningún punto queda más lejos que la tolerancia. Las tolerancias
+// se recorren de mayor a menor sobre la misma malla, así que cada nivel refina al anterior.
+// levels[0] es la triangulación completa y levels[k] la de tolerances[k]; los índices son de
+// d.points, listos para un EBO.
+class TerrainLod {
+public:
+  const vector<Point3>& points;
+  vector<double> tolerances;
+  vector<vector<unsigned int>> levels;
+
+  TerrainLod(const Delaunay& d, vector<double> tolerances);
+
+  // Distancia desde la que el error de cada nivel se ve de menos de `pixels` pixeles en una
+  // pantalla de `screenHeight` pixeles con campo de visión vertical fovY (radianes)
+  vector<float> switchDistances(double pixels, double screenHeight, double fovY) const;
+
+private:
+  // Para encontrar la estrella del vértice recién insertado, y para que la caminata de insert
+  // empiece en el triángulo que ya se sabe que contiene al punto
+  class Mesh : public DynamicDelaunay {
+  public:
+    using DynamicDelaunay::DynamicDelaunay;
+    using DynamicDelaunay::findEdge;
+    void walkFrom(unsigned int t) { lastTri = t; }
+  };
+
+  struct Candidate {
+    double error;
+    unsigned int t, stamp;
+    bool operator<(const Candidate& o) const { return error < o.error; }
+  };
+
+  // Los puntos que faltan insertar, ordenados por la curva de Hilbert para que los de un mismo
+  // triángulo estén cerca en memoria, y su índice en points
+  vector<Point3> pending;
+  vector<unsigned int> pendingId;
+  vector<unsigned int> head;         // Primer punto sin insertar dentro de cada triángulo
+  vector<unsigned int> nextPoint;    // Siguiente punto en la lista de su triángulo
+  vector<unsigned int> best;         // Punto con mayor error de cada triángulo
+  vector<unsigned int> stamp;        // Versión de cada triángulo, para descartar candidatos viejos
+  priority_queue<Candidate> heap;
+
+  void rescan(const Mesh& m, unsigned int t);
+  unsigned int place(const Mesh& m, const vector<unsigned int>& star, unsigned int p) const;
+};
+
+TerrainLod::TerrainLod(const Delaunay& d, vector<double> tol) : points(d.points) {
+  const vector<unsigned int>& T = d.triangles;
+  const vector<unsigned int>& H = d.halfedges;
+  unsigned int n = points.size();
+
+  levels.emplace_back();
+  for (unsigned int t = 0; 3 * t < T.size(); t++) {
+    if (T[3 * t] == INVALID) continue;   // Borrado (DynamicDelaunay)
+    levels[0].insert(levels[0].end(), T.begin() + 3 * t, T.begin() + 3 * t + 3);
+  }
+  if (levels[0].empty()) throw runtime_error("TerrainLod: la triangulación está vacía");
+  tolerances.push_back(0.0);
+  sort(tol.begin(), tol.end(), greater<double>());
+  tol.erase(unique(tol.begin(), tol.end()), tol.end());
+  while (!tol.empty() && tol.back() <= 0.0) tol.pop_back();
+  if (tol.empty()) return;
+
+  // Esquinas de la envolvente: los extremos de aristas sin gemelo donde la envolvente gira
+  unordered_map<unsigned int, unsigned int> hullNext;
+  for (unsigned int e = 0; e < T.size(); e++) {
+    if (T[e] != INVALID && H[e] == INVALID) hullNext[T[e]] = T[nextHalfedge(e)];
+  }
+  vector<unsigned int> orig;         // Índice en points de cada vértice de la malla
+  vector<Point3> corners;
+  vector<char> used(n, 0);
+  for (auto& [u, v] : hullNext) {
+    auto w = hullNext.find(v);
+    if (w == hullNext.end()) continue;
+    const Point3 &a = points[u], &b = points[v], &c = points[w->second];
+    if ((b.x - a.x) * (c.z - b.z) - (b.z - a.z) * (c.x - b.x) == 0.0) continue;
+    orig.push_back(v);
+    corners.push_back(b);
+    used[v] = 1;
+  }
+  if (corners.size() < 3) throw runtime_error("TerrainLod: la envolvente no tiene esquinas");
+  Mesh m(corners);
+
+  double minX = numeric_limits<double>::max(), minZ = minX;
+  double maxX = numeric_limits<double>::lowest(), maxZ = maxX;
+  for (const Point3& c : corners) {
+    minX = min(minX, c.x);
+    minZ = min(minZ, c.z);
+    maxX = max(maxX, c.x);
+    maxZ = max(maxZ, c.z);
+  }
+  double scale = 65535.0 / max(max(maxX - minX, maxZ - minZ), EPSILON);
+  vector<SortKey> keys;
+  for (unsigned int p = 0; p < n; p++) {
+    if (used[p]) continue;
+    double hx = min(65535.0, max(0.0, (points[p].x - minX) * scale));
+    double hy = min(65535.0, max(0.0, (points[p].z - minZ) * scale));
+    keys.push_back({hilbertIndex(static_cast<unsigned int>(hx), static_cast<unsigned int>(hy)), p});
+  }
+  sortKeys(keys);
+  for (const SortKey& k : keys) {
+    pending.push_back(points[k.second]);
+    pendingId.push_back(k.second);
+  }
+
+  // Cada punto que falta va a la lista del triángulo que lo contiene
+  head.assign(m.triangles.size() / 3, INVALID);
+  nextPoint.assign(pending.size(), INVALID);
+  vector<unsigned int> all(m.triangles.size() / 3);
+  for (unsigned int t = 0; t < all.size(); t++) all[t] = t;
+  PointLocator locator(m);
+  for (unsigned int p = pending.size(); p-- > 0;) {
+    unsigned int t = locator.locate(pending[p].x, pending[p].z);
+    if (t == INVALID) t = place(m, all, p);
+    nextPoint[p] = head[t];
+    head[t] = p;
+  }
+  best.assign(head.size(), INVALID);
+  stamp.assign(head.size(), 0);
+  for (unsigned int t = 0; t < head.size(); t++) rescan(m, t);
+
+  vector<unsigned int> star, moved;
+  vector<vector<unsigned int>> coarse;
+  for (double limit : tol) {
+    while (!heap.empty() && heap.top().error > limit) {
+      Candidate c = heap.top();
+      heap.pop();
+      if (c.stamp != stamp[c.t]) continue;
+      unsigned int p = best[c.t];
+
+      // Juntar los puntos del triángulo sin p; si p no se puede insertar (otro vértice en la
+      // misma posición) solo se descarta
+      moved.clear();
+      for (unsigned int q = head[c.t]; q != INVALID; q = nextPoint[q]) {
+        if (q != p) moved.push_back(q);
+      }
+      head[c.t] = INVALID;
+      m.walkFrom(c.t);
+      unsigned int i = m.insert(pending[p]);
+      if (i == INVALID) {
+        star.assign(1, c.t);
+      } else {
+        orig.push_back(pendingId[p]);
+        // Todos los triángulos que cambió la inserción tocan al nuevo vértice: se vacían las
+        // listas de su estrella y se reparten los puntos entre los triángulos nuevos
+        m.walkFrom(c.t);
+        unsigned int e0 = m.findEdge(i);
+        star.clear();
+        unsigned int e = e0;
+        do {
+          star.push_back(e / 3);
+          e = m.halfedges[e] == INVALID ? INVALID : nextHalfedge(m.halfedges[e]);
+        } while (e != INVALID && e != e0);
+        if (e == INVALID) {
+          for (e = m.halfedges[prevHalfedge(e0)]; e != INVALID; e = m.halfedges[prevHalfedge(e)]) {
+            star.push_back(e / 3);
+          }
+        }
+        unsigned int size = m.triangles.size() / 3;
+        if (head.size() < size) {
+          head.resize(size, INVALID);
+          best.resize(size, INVALID);
+          stamp.resize(size, 0);
+        }
+        for (unsigned int t : star) {
+          for (unsigned int q = head[t]; q != INVALID; q = nextPoint[q]) moved.push_back(q);
+          head[t] = INVALID;
+        }
+      }
+      // Al revés, para que cada lista siga en el orden de la curva
+      for (auto it = moved.rbegin(); it != moved.rend(); ++it) {
+        unsigned int q = *it;
+        unsigned int t = place(m, star, q);
+        nextPoint[q] = head[t];
+        head[t] = q;
+      }
+      for (unsigned int t : star) rescan(m, t);
+    }
+
+    coarse.emplace_back();
+    for (unsigned int v : m.triangles) coarse.back().push_back(orig[v]);
+    tolerances.push_back(limit);
+  }
+
+  // Se generaron de la más gruesa a la más fina
+  reverse(tolerances.begin() + 1, tolerances.end());
+  for (auto it = coarse.rbegin(); it != coarse.rend(); ++it) levels.push_back(move(*it));
+  pending.clear();
+  pendingId.clear();
+  head.clear();
+  nextPoint.clear();
+  best.clear();
+  stamp.clear();
+  heap = {};
+}
+
+// Triángulo de `candidates` que contiene al punto p; por redondeo puede no estar en ninguno
+// (puntos justo en el borde), y entonces es el que menos le queda afuera
+unsigned int TerrainLod::place(const Mesh& m, const vector<unsigned int>& candidates, unsigned int p) const {
+  const vector<unsigned int>& T = m.triangles;
+  const vector<Point3>& P = m.points;
+  double x = pending[p].x, z = pending[p].z;
+  auto side = [&](unsigned int t, unsigned int j) {
+    const Point3& a = P[T[3 * t + j]];
+    const Point3& b = P[T[3 * t + (j + 1) % 3]];
+    return (a.x - x) * (b.z - z) - (a.z - z) * (b.x - x);
+  };
+  for (unsigned int t : candidates) {
+    if (side(t, 0) <= 0.0 && side(t, 1) <= 0.0 && side(t, 2) <= 0.0) return t;
+  }
+
+  // Distancia afuera de cada triángulo: el mayor producto cruz dividido entre su arista
+  unsigned int closest = candidates[0];
+  double closestOut = numeric_limits<double>::max();
+  for (unsigned int t : candidates) {
+    double out = numeric_limits<double>::lowest();
+    for (unsigned int j = 0; j < 3; j++) {
+      const Point3& a = P[T[3 * t + j]];
+      const Point3& b = P[T[3 * t + (j + 1) % 3]];
+      out = max(out, side(t, j) / max(sqrt(distSq(a.x, a.z, b.x, b.z)), EPSILON));
+    }
+    if (out < closestOut) {
+      closestOut = out;
+      closest = t;
+    }
+  }
+  return closest;
+}
+
+// Busca el punto con más error del triángulo t y lo pone en el montículo
+void TerrainLod::rescan(const Mesh& m, unsigned int t) {
+  stamp[t]++;
+  best[t] = INVALID;
+  if (head[t] == INVALID) return;
+  const Point3& a = m.points[m.triangles[3 * t]];
+  const Point3& b = m.points[m.triangles[3 * t + 1]];
+  const Point3& c = m.points[m.triangles[3 * t + 2]];
+  double d = (b.x - a.x) * (c.z - a.z) - (b.z - a.z) * (c.x - a.x);
+  double error = -1.0;
+  for (unsigned int q = head[t]; q != INVALID; q = nextPoint[q]) {
+    const Point3& p = pending[q];
+    double e;
+    if (d == 0.0) {
+      e = numeric_limits<double>::max();   // Triángulo plano: hay que refinarlo
+    } else {
+      double u = ((b.x - p.x) * (c.z - p.z) - (b.z - p.z) * (c.x - p.x)) / d;
+      double v = ((c.x - p.x) * (a.z - p.z) - (c.z - p.z) * (a.x - p.x)) / d;
+      e = fabs(p.y - (u * a.y + v * b.y + (1.0 - u - v) * c.y));
+    }
+    if (e > error) {
+      error = e;
+      best[t] = q;
+    }
+  }
+  heap.push({error, t, stamp[t]});
+}
+
+vector<float> TerrainLod::switchDistances(double pixels, double screenHeight, double fovY) const {
+  vector<float> distance(tolerances.size());
+  double scale = screenHeight / (2.0 * tan(0.5 * fovY) * pixels);
+  for (unsigned int k = 0; k < tolerances.size(); k++) distance[k] = tolerances[k] * scale;
+  return distance;
+}
+
+#endif
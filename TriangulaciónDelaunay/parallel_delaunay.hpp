@@ -0,0 +1,259 @@
+#ifndef PARALLEL_DELAUNAY_H
+#define PARALLEL_DELAUNAY_H
+
+#include "delaunay.hpp"
+#include <thread>
+#include <unordered_map>
+#include <numeric>
+
+using namespace std;
+
+// Triangulación de Delaunay en paralelo por franjas verticales (en x).
+// 1. Se parten los puntos en tantas franjas como hilos y cada hilo triangula la suya con Delaunay.
+// 2. Un triángulo de una franja cuyo círculo circunscrito no sale de la franja no puede tener
+//    puntos de otra franja adentro, así que es de la triangulación global: es "final".
+// 3. Los vértices de los triángulos no finales (y los de la envolvente de cada franja) se
+//    triangulan juntos; son pocos, los que quedan cerca de las fronteras entre franjas.
+// 4. De esa triangulación de la frontera se quedan los triángulos que están del lado no final
+//    de las aristas finales (se llenan a partir de ellas) y se cosen con los finales.
+// El resultado son los mismos arreglos triangles/halfedges que Delaunay, sobre los índices de input.
+class ParallelDelaunay {
+public:
+  const vector<Point3>& points;
+  vector<unsigned int> triangles;
+  vector<unsigned int> halfedges;
+
+  // threads = 0 usa todos los núcleos
+  ParallelDelaunay(const vector<Point3>& input, unsigned int threads = 0);
+
+private:
+  struct Strip {
+    vector<unsigned int> ids;               // Índice global de cada punto de la franja
+    vector<Point3> pts;
+    vector<unsigned int> triangles, halfedges;
+    vector<unsigned int> outTri;            // Triángulo de salida de cada triángulo final, o INVALID
+    vector<unsigned long long> border;      // Aristas finales sin gemelo final: (u, v) y su halfedge de salida
+    vector<unsigned int> borderEdge;
+    double minX, maxX;
+    bool failed = false;                    // La franja sola no se pudo triangular (colineal)
+    unsigned int finals = 0;
+  };
+
+  void sequential();
+  void triangulateStrip(Strip& s);
+  void classifyStrip(Strip& s, double lo, double hi);
+  void writeStrip(Strip& s, unsigned int base);
+};
+
+// Con pocos puntos por hilo no vale la pena partir
+#define PARALLEL_DELAUNAY_MIN_POINTS 20000
+
+ParallelDelaunay::ParallelDelaunay(const vector<Point3>& input, unsigned int threads) : points(input) {
+  unsigned int n = points.size();
+  if (threads == 0) threads = max(1u, thread::hardware_concurrency());
+  threads = min(threads, n / PARALLEL_DELAUNAY_MIN_POINTS);
+  if (threads <= 1) {
+    sequential();
+    return;
+  }
+
+  // Partir en franjas con nth_element, ordenando por x y desempatando por z y por índice
+  vector<unsigned int> ids(n);
+  iota(ids.begin(), ids.end(), 0);
+  auto byX = [&](unsigned int a, unsigned int b) {
+    if (points[a].x != points[b].x) return points[a].x < points[b].x;
+    if (points[a].z != points[b].z) return points[a].z < points[b].z;
+    return a < b;
+  };
+  vector<unsigned int> cut(threads + 1);
+  for (unsigned int k = 0; k <= threads; k++) cut[k] = static_cast<unsigned long long>(n) * k / threads;
+  // Cada corte solo busca dentro del tramo que dejó el corte anterior
+  for (unsigned int k = 1; k < threads; k++) {
+    nth_element(ids.begin() + cut[k-1], ids.begin() + cut[k], ids.end(), byX);
+  }
+
+  vector<Strip> strips(threads);
+  vector<thread> pool;
+  for (unsigned int k = 0; k < threads; k++) {
+    strips[k].ids.assign(ids.begin() + cut[k], ids.begin() + cut[k+1]);
+    pool.emplace_back([&, k] { triangulateStrip(strips[k]); });
+  }
+  for (auto& th : pool) th.join();
+  pool.clear();
+
+  // Un triángulo es final si su círculo queda estrictamente entre las franjas vecinas
+  for (unsigned int k = 0; k < threads; k++) {
+    double lo = k > 0 ? strips[k-1].maxX : numeric_limits<double>::lowest();
+    double hi = k + 1 < threads ? strips[k+1].minX : numeric_limits<double>::max();
+    pool.emplace_back([&, k, lo, hi] { classifyStrip(strips[k], lo, hi); });
+  }
+  for (auto& th : pool) th.join();
+  pool.clear();
+
+  // Puntos de la frontera: vértices de triángulos no finales y de las envolventes de las franjas
+  vector<unsigned int> borderIds;
+  for (auto& s : strips) {
+    vector<char> mark(s.pts.size(), s.failed);
+    for (unsigned int e = 0; e < s.triangles.size(); e++) {
+      unsigned int t = e / 3;
+      if (s.outTri[t] == INVALID || s.halfedges[e] == INVALID) mark[s.triangles[e]] = 1;
+      if (s.halfedges[e] == INVALID) mark[s.triangles[t * 3 + (e + 1) % 3]] = 1;
+    }
+    for (unsigned int i = 0; i < mark.size(); i++) if (mark[i]) borderIds.push_back(s.ids[i]);
+  }
+  // En orden de índice, como en las franjas (ver triangulateStrip)
+  sort(borderIds.begin(), borderIds.end());
+  vector<Point3> borderPts(borderIds.size());
+  for (unsigned int i = 0; i < borderIds.size(); i++) borderPts[i] = points[borderIds[i]];
+
+  unsigned int finals = 0;
+  vector<unsigned int> base(threads);
+  for (unsigned int k = 0; k < threads; k++) {
+    base[k] = finals;
+    finals += strips[k].finals;
+  }
+
+  vector<unsigned int> bt, bh;
+  try {
+    Delaunay b(borderPts);
+    bt = move(b.triangles);
+    bh = move(b.halfedges);
+  } catch (const runtime_error&) {
+    // Frontera degenerada (por ejemplo todos los puntos en una línea): se hace todo junto
+    sequential();
+    return;
+  }
+
+  // Copiar los triángulos finales en paralelo, cada franja en su tramo de la salida
+  triangles.resize(3 * finals);
+  halfedges.resize(3 * finals);
+  for (unsigned int k = 0; k < threads; k++) {
+    pool.emplace_back([&, k] { writeStrip(strips[k], base[k]); });
+  }
+  for (auto& th : pool) th.join();
+  pool.clear();
+
+  unordered_map<unsigned long long, unsigned int> finalEdge;
+  for (auto& s : strips) {
+    for (unsigned int j = 0; j < s.border.size(); j++) finalEdge[s.border[j]] = s.borderEdge[j];
+  }
+
+  // Triángulos de la frontera que están del lado no final: se llenan desde las aristas finales
+  // sin cruzarlas. Si no hay triángulos finales toda la triangulación de la frontera sirve.
+  unsigned int bn = bt.size() / 3;
+  vector<char> keep(bn, finals == 0);
+  vector<unsigned int> stack;
+  auto across = [&](unsigned int e) {
+    unsigned int u = borderIds[bt[e]], v = borderIds[bt[3 * (e / 3) + (e + 1) % 3]];
+    auto it = finalEdge.find(edgeKey(v, u));
+    return it == finalEdge.end() ? INVALID : it->second;
+  };
+  for (unsigned int e = 0; e < bt.size(); e++) {
+    if (!keep[e / 3] && across(e) != INVALID) {
+      keep[e / 3] = 1;
+      stack.push_back(e / 3);
+    }
+  }
+  while (!stack.empty()) {
+    unsigned int t = stack.back();
+    stack.pop_back();
+    for (unsigned int e = 3 * t; e < 3 * t + 3; e++) {
+      unsigned int tw = bh[e];
+      if (tw == INVALID || keep[tw / 3] || across(e) != INVALID) continue;
+      keep[tw / 3] = 1;
+      stack.push_back(tw / 3);
+    }
+  }
+
+  // Agregar los triángulos de la frontera y coserlos con los finales
+  vector<unsigned int> outB(bn, INVALID);
+  unsigned int next = finals;
+  for (unsigned int t = 0; t < bn; t++) if (keep[t]) outB[t] = next++;
+  triangles.resize(3 * next);
+  halfedges.resize(3 * next, INVALID);
+  for (unsigned int t = 0; t < bn; t++) {
+    if (!keep[t]) continue;
+    for (unsigned int j = 0; j < 3; j++) {
+      unsigned int e = 3 * t + j, o = 3 * outB[t] + j;
+      triangles[o] = borderIds[bt[e]];
+      unsigned int tw = bh[e];
+      if (tw != INVALID && keep[tw / 3]) {
+        halfedges[o] = 3 * outB[tw / 3] + tw % 3;
+      } else {
+        unsigned int f = across(e);
+        halfedges[o] = f;
+        if (f != INVALID) halfedges[f] = o;
+      }
+    }
+  }
+}
+
+void ParallelDelaunay::sequential() {
+  Delaunay d(points);
+  triangles = move(d.triangles);
+  halfedges = move(d.halfedges);
+}
+
+void ParallelDelaunay::triangulateStrip(Strip& s) {
+  // En orden de índice global: los empates de InCircle se rompen por índice y el de menor índice
+  // es el que se queda de los repetidos, así que con el orden local igual al global el resultado
+  // es el de Delaunay sobre todos los puntos, con cualquier número de hilos
+  sort(s.ids.begin(), s.ids.end());
+  s.pts.resize(s.ids.size());
+  s.minX = numeric_limits<double>::max();
+  s.maxX = numeric_limits<double>::lowest();
+  for (unsigned int i = 0; i < s.ids.size(); i++) {
+    s.pts[i] = points[s.ids[i]];
+    s.minX = min(s.minX, s.pts[i].x);
+    s.maxX = max(s.maxX, s.pts[i].x);
+  }
+  try {
+    Delaunay d(s.pts);
+    s.triangles = move(d.triangles);
+    s.halfedges = move(d.halfedges);
+  } catch (const runtime_error&) {
+    s.failed = true;
+  }
+}
+
+void ParallelDelaunay::classifyStrip(Strip& s, double lo, double hi) {
+  unsigned int m = s.triangles.size() / 3;
+  s.outTri.assign(m, INVALID);
+  for (unsigned int t = 0; t < m; t++) {
+    const Point3& a = s.pts[s.triangles[3 * t]];
+    const Point3& b = s.pts[s.triangles[3 * t + 1]];
+    const Point3& c = s.pts[s.triangles[3 * t + 2]];
+    double dx = b.x - a.x, dy = b.z - a.z;
+    double ex = c.x - a.x, ey = c.z - a.z;
+    double bl = dx * dx + dy * dy;
+    double cl = ex * ex + ey * ey;
+    double d = dx * ey - dy * ex;
+    if (orient2d(a.x, a.z, b.x, b.z, c.x, c.z) == 0.0) continue;
+    double ox = a.x + (ey * bl - dy * cl) * 0.5 / d;
+    double oy = a.z + (dx * cl - ex * bl) * 0.5 / d;
+    double r = sqrt(distSq(ox, oy, a.x, a.z));
+    // Margen para el error de redondeo del centro y el radio
+    double margin = EPSILON * (1.0 + fabs(ox) + r);
+    if (ox - r > lo + margin && ox + r < hi - margin) s.outTri[t] = s.finals++;
+  }
+}
+
+void ParallelDelaunay::writeStrip(Strip& s, unsigned int base) {
+  for (unsigned int e = 0; e < s.triangles.size(); e++) {
+    unsigned int t = e / 3;
+    if (s.outTri[t] == INVALID) continue;
+    unsigned int o = 3 * (base + s.outTri[t]) + e % 3;
+    triangles[o] = s.ids[s.triangles[e]];
+    unsigned int tw = s.halfedges[e];
+    if (tw != INVALID && s.outTri[tw / 3] != INVALID) {
+      halfedges[o] = 3 * (base + s.outTri[tw / 3]) + tw % 3;
+    } else {
+      halfedges[o] = INVALID;
+      unsigned int v = s.ids[s.triangles[3 * t + (e + 1) % 3]];
+      s.border.push_back(edgeKey(triangles[o], v));
+      s.borderEdge.push_back(o);
+    }
+  }
+}
+
+#endif
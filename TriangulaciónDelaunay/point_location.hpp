@@ -0,0 +1,167 @@
+#ifndef POINT_LOCATION_H
+#define POINT_LOCATION_H
+
+#include "delaunay.hpp"
+
+using namespace std;
+
+// Localización de puntos sobre una triangulación ya hecha (saltar y caminar): una rejilla
+// gruesa guarda por celda un triángulo con un vértice en ella; para cada consulta se salta al
+// triángulo de su celda y desde ahí se camina por halfedges hasta el triángulo que la
+// contiene. locate regresa el índice del triángulo, o INVALID si el punto está fuera de la
+// envolvente. La triangulación no se modifica, así que se puede consultar desde varios hilos.
+class PointLocator {
+public:
+  const Delaunay& delaunay;
+
+  PointLocator(const Delaunay& d);
+
+  unsigned int locate(double x, double z) const;
+  // Caminar desde el triángulo start (INVALID = el de la rejilla)
+  unsigned int locate(double x, double z, unsigned int start) const;
+  // Todas las consultas: se ordenan por la curva de Hilbert para que cada caminata empiece
+  // en el resultado de la anterior, y se reparten entre hilos (0 = todos los núcleos)
+  vector<unsigned int> locate(const vector<Point3>& queries, unsigned int threads = 0) const;
+
+private:
+  double minX, minZ, cellSize;
+  unsigned int cols, rows;
+  vector<unsigned int> seeds;   // Triángulo de cada celda de la rejilla
+  unsigned int anyTriangle = INVALID;
+
+  unsigned int cellOf(double x, double z) const;
+};
+
+// Triángulos por celda de la rejilla, y consultas por hilo para que valga la pena partir
+#define POINT_LOCATION_TRIANGLES_PER_CELL 4
+#define POINT_LOCATION_MIN_PER_THREAD (1u << 14)
+
+PointLocator::PointLocator(const Delaunay& d) : delaunay(d) {
+  const vector<unsigned int>& T = d.triangles;
+  const vector<Point3>& P = d.points;
+  unsigned int m = T.size() / 3;
+
+  double maxX = numeric_limits<double>::lowest(), maxZ = maxX;
+  minX = minZ = numeric_limits<double>::max();
+  for (unsigned int t = 0; t < m; t++) {
+    if (T[3 * t] == INVALID) continue;  // Borrado
+    if (anyTriangle == INVALID) anyTriangle = t;
+    for (unsigned int j = 0; j < 3; j++) {
+      const Point3& p = P[T[3 * t + j]];
+      minX = min(minX, p.x);
+      minZ = min(minZ, p.z);
+      maxX = max(maxX, p.x);
+      maxZ = max(maxZ, p.z);
+    }
+  }
+  if (anyTriangle == INVALID) throw runtime_error("PointLocator: la triangulación está vacía");
+
+  // Celdas cuadradas, unas m / POINT_LOCATION_TRIANGLES_PER_CELL en total
+  double w = max(maxX - minX, EPSILON), h = max(maxZ - minZ, EPSILON);
+  double cells = max(1.0, static_cast<double>(m) / POINT_LOCATION_TRIANGLES_PER_CELL);
+  cellSize = sqrt(w * h / cells);
+  cols = min(65536u, static_cast<unsigned int>(w / cellSize) + 1);
+  rows = min(65536u, static_cast<unsigned int>(h / cellSize) + 1);
+  cellSize = max(w / cols, h / rows);
+
+  seeds.assign(static_cast<size_t>(cols) * rows, INVALID);
+  for (unsigned int t = 0; t < m; t++) {
+    if (T[3 * t] == INVALID) continue;
+    const Point3& p = P[T[3 * t]];
+    unsigned int c = cellOf(p.x, p.z);
+    if (seeds[c] == INVALID) seeds[c] = t;
+  }
+  // Las celdas sin vértices usan la última celda llena antes de ellas, recorriendo por filas
+  unsigned int last = anyTriangle;
+  for (unsigned int& s : seeds) {
+    if (s == INVALID) s = last;
+    else last = s;
+  }
+}
+
+unsigned int PointLocator::cellOf(double x, double z) const {
+  // Se acota en double antes de convertir: una consulta muy lejos (o NaN) no cabe en unsigned
+  double cx = (x - minX) / cellSize, cz = (z - minZ) / cellSize;
+  unsigned int i = cx > 0 ? static_cast<unsigned int>(min(cx, cols - 1.0)) : 0;
+  unsigned int j = cz > 0 ? static_cast<unsigned int>(min(cz, rows - 1.0)) : 0;
+  return j * cols + i;
+}
+
+unsigned int PointLocator::locate(double x, double z) const {
+  return locate(x, z, INVALID);
+}
+
+// Igual que la caminata de Delaunay::locate, pero sin tocar el estado de la triangulación.
+// Salir por una arista de la envolvente quiere decir que el punto está afuera, porque la
+// envolvente es convexa.
+unsigned int PointLocator::locate(double x, double z, unsigned int start) const {
+  const vector<unsigned int>& T = delaunay.triangles;
+  const vector<unsigned int>& H = delaunay.halfedges;
+  const vector<Point3>& P = delaunay.points;
+  if (start == INVALID || T[3 * start] == INVALID) start = seeds[cellOf(x, z)];
+
+  unsigned int t = 3 * start;
+  unsigned int rot = 0;
+  unsigned int maxSteps = T.size();
+  for (unsigned int step = 0; step <= maxSteps; step++) {
+    bool moved = false;
+    for (unsigned int j = 0; j < 3 && !moved; j++) {
+      // Empezar por una arista distinta cada vez evita ciclos con puntos degenerados
+      unsigned int e = t + (j + rot) % 3;
+      unsigned int a = T[e];
+      unsigned int b = T[nextHalfedge(e)];
+      if (orient2d(P[a].x, P[a].z, P[b].x, P[b].z, x, z) <= 0.0) continue;
+      if (H[e] == INVALID) return INVALID;
+      t = 3 * (H[e] / 3);
+      moved = true;
+    }
+    if (!moved) return t / 3;
+    rot++;
+  }
+
+  // La caminata no terminó (no debería pasar): buscar en todos los triángulos
+  for (t = 0; t < T.size(); t += 3) {
+    if (T[t] == INVALID) continue;
+    bool inside = true;
+    for (unsigned int j = 0; j < 3 && inside; j++) {
+      unsigned int a = T[t + j];
+      unsigned int b = T[t + (j + 1) % 3];
+      if (orient2d(P[a].x, P[a].z, P[b].x, P[b].z, x, z) > 0.0) inside = false;
+    }
+    if (inside) return t / 3;
+  }
+  return INVALID;
+}
+
+vector<unsigned int> PointLocator::locate(const vector<Point3>& queries, unsigned int threads) const {
+  unsigned int n = queries.size();
+  vector<unsigned int> result(n, INVALID);
+  if (threads == 0) threads = max(1u, thread::hardware_concurrency());
+  threads = max(1u, min(threads, n / POINT_LOCATION_MIN_PER_THREAD));
+
+  // Orden de Hilbert sobre la caja de la rejilla; las consultas de afuera quedan en el borde
+  double s = 65535.0 / (cellSize * max(cols, rows));
+  vector<SortKey> keys(n);
+  forChunks(n, threads, [&](unsigned int lo, unsigned int hi, unsigned int) {
+    for (unsigned int k = lo; k < hi; k++) {
+      double hx = min(65535.0, max(0.0, (queries[k].x - minX) * s));
+      double hy = min(65535.0, max(0.0, (queries[k].z - minZ) * s));
+      keys[k] = {hilbertIndex(static_cast<unsigned int>(hx), static_cast<unsigned int>(hy)), k};
+    }
+  });
+  sortKeys(keys);
+
+  // Cada hilo camina su tramo de la curva empezando en el resultado anterior; después de una
+  // consulta de afuera se vuelve a saltar desde la rejilla
+  forChunks(n, threads, [&](unsigned int lo, unsigned int hi, unsigned int) {
+    unsigned int prev = INVALID;
+    for (unsigned int k = lo; k < hi; k++) {
+      const Point3& q = queries[keys[k].second];
+      prev = locate(q.x, q.z, prev);
+      result[keys[k].second] = prev;
+    }
+  });
+  return result;
+}
+
+#endif
@@ -13,33 +13,53 @@ class Renderer{
     unsigned int VAO, VBO, EBO;
     unsigned int indexCount;
 		unsigned int vertexCount;
+    // Niveles de detalle: todos van en el mismo EBO, uno tras otro
+    vector<unsigned int> lodOffset, lodCount;
+    vector<float> lodDistance;
 
     public:
     Renderer(const vector<float> vertices, const vector<unsigned int> indices):indexCount(indices.size()), vertexCount(vertices.size()/3){
-        glGenVertexArrays(1, &VAO);
-        glGenBuffers(1, &VBO);
-        glGenBuffers(1, &EBO);
-
-        glBindVertexArray(VAO);
+        upload(vertices, indices);
+        lodOffset = {0};
+        lodCount = {indexCount};
+        lodDistance = {0.0f};
+    }
 
-        glBindBuffer(GL_ARRAY_BUFFER, VBO);
-        glBufferData(GL_ARRAY_BUFFER, vertices.size()*sizeof(float), vertices.data(), GL_STATIC_DRAW);
-        
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size()*sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
-        
-        GLsizei stride = 3*sizeof(float);
+    // levels[k] se dibuja desde distances[k] (creciente, el primero en 0); drawTriangles sigue
+    // dibujando levels[0]
+    Renderer(const vector<float> vertices, const vector<vector<unsigned int>>& levels, const vector<float>& distances)
+        :vertexCount(vertices.size()/3), lodDistance(distances){
+        vector<unsigned int> indices;
+        for(const vector<unsigned int>& level: levels){
+            lodOffset.push_back(indices.size());
+            lodCount.push_back(level.size());
+            indices.insert(indices.end(), level.begin(), level.end());
+        }
+        indexCount = lodCount.empty() ? 0 : lodCount[0];
+        lodDistance.resize(levels.size(), lodDistance.empty() ? 0.0f : lodDistance.back());
+        upload(vertices, indices);
+    }
 
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
-        glEnableVertexAttribArray(0);
+    void drawTriangles(unsigned int shaderProgram, const glm::mat4 mvp, const glm::mat4& model, const glm::vec3& color, unsigned int drawCount){
+        int mvpLocation = glGetUniformLocation(shaderProgram, "u_MVP"); 
+        int modelLocation = glGetUniformLocation(shaderProgram, "u_Model"); 
+        int colorLocation = glGetUniformLocation(shaderProgram, "u_ObjectColor"); 
 
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void*)(3*sizeof(float)));
-        glEnableVertexAttribArray(1);
+        glUniformMatrix4fv(mvpLocation, 1, GL_FALSE, glm::value_ptr(mvp));
+        glUniformMatrix4fv(modelLocation, 1, GL_FALSE, glm::value_ptr(model));
+        glUniform3fv(colorLocation, 1, glm::value_ptr(color));
 
+        glBindVertexArray(VAO);
+        glDrawElements(GL_TRIANGLES, drawCount, GL_UNSIGNED_INT, nullptr);
         glBindVertexArray(0);
     }
 
-    void drawTriangles(unsigned int shaderProgram, const glm::mat4 mvp, const glm::mat4& model, const glm::vec3& color, unsigned int drawCount){
+    // Dibuja el nivel más grueso cuya distancia ya se alcanzó
+    void drawLod(unsigned int shaderProgram, const glm::mat4 mvp, const glm::mat4& model, const glm::vec3& color, float distance){
+        if(lodCount.empty()) return;
+        unsigned int level = 0;
+        while(level + 1 < lodCount.size() && lodDistance[level + 1] <= distance) level++;
+
         int mvpLocation = glGetUniformLocation(shaderProgram, "u_MVP"); 
         int modelLocation = glGetUniformLocation(shaderProgram, "u_Model"); 
         int colorLocation = glGetUniformLocation(shaderProgram, "u_ObjectColor"); 
@@ -49,7 +69,7 @@ class Renderer{
         glUniform3fv(colorLocation, 1, glm::value_ptr(color));
 
         glBindVertexArray(VAO);
-        glDrawElements(GL_TRIANGLES, drawCount, GL_UNSIGNED_INT, nullptr);
+        glDrawElements(GL_TRIANGLES, lodCount[level], GL_UNSIGNED_INT, (void*)(lodOffset[level]*sizeof(unsigned int)));
         glBindVertexArray(0);
     }
 
@@ -73,5 +93,30 @@ class Renderer{
         glDeleteBuffers(1, &VBO);
         glDeleteVertexArrays(1, &VAO);
     }
+
+    private:
+    void upload(const vector<float>& vertices, const vector<unsigned int>& indices){
+        glGenVertexArrays(1, &VAO);
+        glGenBuffers(1, &VBO);
+        glGenBuffers(1, &EBO);
+
+        glBindVertexArray(VAO);
+
+        glBindBuffer(GL_ARRAY_BUFFER, VBO);
+        glBufferData(GL_ARRAY_BUFFER, vertices.size()*sizeof(float), vertices.data(), GL_STATIC_DRAW);
+        
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size()*sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+        
+        GLsizei stride = 3*sizeof(float);
+
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
+        glEnableVertexAttribArray(0);
+
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void*)(3*sizeof(float)));
+        glEnableVertexAttribArray(1);
+
+        glBindVertexArray(0);
+    }
 };
 #endif
\ No newline at end of file
@@ -0,0 +1,252 @@
+#ifndef STREAMING_DELAUNAY_H
+#define STREAMING_DELAUNAY_H
+
+#include "delaunay.hpp"
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstdio>
+#include <functional>
+#include <unordered_map>
+
+using namespace std;
+
+// Triangulación de Delaunay de un archivo que no cabe en memoria (finalización espacial).
+// 1. Una pasada por el archivo ("x y z" por línea, como readInput) mide la caja.
+// 2. Otra pasada cuenta los puntos de cada celda de una rejilla y los reparte por filas de
+//    celdas en archivos temporales. Las filas van a lo largo del lado mayor de la caja (franjas
+//    en z, o en x si la caja es más larga en x), para que una franja larga y angosta como una
+//    línea de vuelo también se parta en filas.
+// 3. Las filas se procesan en orden: los puntos de la fila se triangulan junto con el frente (los
+//    puntos que siguen haciendo falta de las filas anteriores). Un triángulo cuyo círculo no toca
+//    ninguna celda a la que todavía le faltan puntos ya no puede cambiar: se escribe y se olvida.
+//    Como en ParallelDelaunay, de la triangulación del frente solo sirven los triángulos del lado
+//    no escrito de las aristas ya escritas.
+// En memoria solo están la fila y el frente. La salida son tres unsigned int por triángulo, con el
+// índice de cada vértice entre los puntos válidos del archivo (el mismo que daría readInput).
+class StreamingDelaunay {
+public:
+  unsigned int pointCount = 0;
+  unsigned long long triangleCount = 0;
+  size_t maxActive = 0;                 // Más puntos en memoria a la vez
+
+  StreamingDelaunay(const string& input, const string& output, unsigned int pointsPerRow = 0);
+
+private:
+  struct Record {
+    unsigned int id;
+    Point3 p;
+  };
+
+  double minX, minZ, maxX, maxZ, cellSize;
+  bool alongX;                          // Las filas avanzan en x en lugar de z
+  unsigned int cols, rows;
+  vector<unsigned int> rowPrefix;       // Por fila, puntos acumulados por columna: rowPrefix[j * (cols + 1) + i]
+
+  unsigned int cellCol(double x, double z) const;
+  unsigned int cellRow(double x, double z) const;
+  bool pendingIn(unsigned int row, double x0, double z0, double x1, double z1) const;
+  void readPoints(const string& input, const function<void(const Point3&)>& f) const;
+};
+
+// Puntos por fila si no se dice, y tope de filas (un archivo temporal abierto por fila)
+#define STREAMING_POINTS_PER_ROW (1u << 20)
+#define STREAMING_MAX_ROWS 256u
+
+StreamingDelaunay::StreamingDelaunay(const string& input, const string& output, unsigned int pointsPerRow) {
+  if (pointsPerRow == 0) pointsPerRow = STREAMING_POINTS_PER_ROW;
+
+  // Pasada 1: caja y número de puntos
+  minX = minZ = numeric_limits<double>::max();
+  maxX = maxZ = numeric_limits<double>::lowest();
+  readPoints(input, [&](const Point3& p) {
+    minX = min(minX, p.x);
+    minZ = min(minZ, p.z);
+    maxX = max(maxX, p.x);
+    maxZ = max(maxZ, p.z);
+    pointCount++;
+  });
+  ofstream out(output, ios::binary);
+  if (!out.is_open()) throw runtime_error("StreamingDelaunay: no se pudo crear " + output);
+  if (pointCount < 3) return;
+
+  // Celdas cuadradas; como las filas van por el lado mayor, hay a lo más rows + 1 columnas
+  alongX = maxX - minX > maxZ - minZ;
+  double along = max(alongX ? maxX - minX : maxZ - minZ, EPSILON);
+  double across = max(alongX ? maxZ - minZ : maxX - minX, EPSILON);
+  rows = min(STREAMING_MAX_ROWS, max(1u, (pointCount + pointsPerRow - 1) / pointsPerRow));
+  cellSize = along / rows;
+  cols = static_cast<unsigned int>(across / cellSize) + 1;
+
+  // Pasada 2: cuentas por celda y un archivo por fila
+  vector<string> rowFile(rows);
+  vector<ofstream> rowOut(rows);
+  for (unsigned int j = 0; j < rows; j++) {
+    rowFile[j] = output + ".fila" + to_string(j);
+    rowOut[j].open(rowFile[j], ios::binary);
+    if (!rowOut[j].is_open()) throw runtime_error("StreamingDelaunay: no se pudo crear " + rowFile[j]);
+  }
+  rowPrefix.assign(static_cast<size_t>(rows) * (cols + 1), 0);
+  unsigned int id = 0;
+  readPoints(input, [&](const Point3& p) {
+    unsigned int j = cellRow(p.x, p.z);
+    rowPrefix[static_cast<size_t>(j) * (cols + 1) + cellCol(p.x, p.z) + 1]++;
+    Record r{id++, p};
+    rowOut[j].write(reinterpret_cast<const char*>(&r), sizeof(r));
+  });
+  for (unsigned int j = 0; j < rows; j++) {
+    rowOut[j].close();
+    unsigned int* pre = rowPrefix.data() + static_cast<size_t>(j) * (cols + 1);
+    for (unsigned int i = 0; i < cols; i++) pre[i + 1] += pre[i];
+  }
+
+  // Aristas de los triángulos escritos que no tienen del otro lado otro triángulo escrito,
+  // edgeKey(u, v) en el sentido de su triángulo, con índices del archivo
+  unordered_map<unsigned long long, char> written;
+  vector<Record> active;
+  vector<unsigned int> ids;
+  vector<Point3> pts;
+  for (unsigned int j = 0; j < rows; j++) {
+    size_t front = active.size();
+    ifstream in(rowFile[j], ios::binary);
+    Record r;
+    while (in.read(reinterpret_cast<char*>(&r), sizeof(r))) active.push_back(r);
+    in.close();
+    remove(rowFile[j].c_str());
+    maxActive = max(maxActive, active.size());
+
+    // En el orden del archivo, para que los empates de InCircle (que se rompen por índice)
+    // salgan igual que con Delaunay sobre todos los puntos. El frente y la fila ya vienen ordenados.
+    inplace_merge(active.begin(), active.begin() + front, active.end(),
+                  [](const Record& a, const Record& b) { return a.id < b.id; });
+    ids.resize(active.size());
+    pts.resize(active.size());
+    for (size_t k = 0; k < active.size(); k++) {
+      ids[k] = active[k].id;
+      pts[k] = active[k].p;
+    }
+
+    bool last = j + 1 == rows;
+    vector<unsigned int> T, H;
+    try {
+      Delaunay d(pts, BRIO);
+      T = move(d.triangles);
+      H = move(d.halfedges);
+    } catch (const runtime_error&) {
+      // Todos colineales por ahora: pasan completos a la siguiente fila
+      continue;
+    }
+
+    // Triángulos del lado no escrito: se llenan desde las aristas escritas sin cruzarlas; si
+    // todavía no hay nada escrito sirven todos
+    unsigned int m = T.size() / 3;
+    vector<char> keep(m, written.empty());
+    vector<unsigned int> stack;
+    auto across = [&](unsigned int e) {
+      return written.count(edgeKey(ids[T[nextHalfedge(e)]], ids[T[e]])) > 0;
+    };
+    for (unsigned int e = 0; e < T.size(); e++) {
+      if (!keep[e / 3] && across(e)) {
+        keep[e / 3] = 1;
+        stack.push_back(e / 3);
+      }
+    }
+    while (!stack.empty()) {
+      unsigned int t = stack.back();
+      stack.pop_back();
+      for (unsigned int e = 3 * t; e < 3 * t + 3; e++) {
+        unsigned int tw = H[e];
+        if (tw == INVALID || keep[tw / 3] || across(e)) continue;
+        keep[tw / 3] = 1;
+        stack.push_back(tw / 3);
+      }
+    }
+
+    // Escribir los que ya no cambian y marcar los puntos que siguen en el frente
+    vector<char> keepPoint(pts.size(), 0);
+    vector<unsigned int> tri(3);
+    for (unsigned int t = 0; t < m; t++) {
+      if (!keep[t]) continue;
+      const Point3& a = pts[T[3 * t]];
+      const Point3& b = pts[T[3 * t + 1]];
+      const Point3& c = pts[T[3 * t + 2]];
+      bool done = last;
+      if (!done) {
+        double dx = b.x - a.x, dy = b.z - a.z;
+        double ex = c.x - a.x, ey = c.z - a.z;
+        double bl = dx * dx + dy * dy;
+        double cl = ex * ex + ey * ey;
+        double d = dx * ey - dy * ex;
+        if (fabs(d) >= EPSILON) {
+          double ox = a.x + (ey * bl - dy * cl) * 0.5 / d;
+          double oz = a.z + (dx * cl - ex * bl) * 0.5 / d;
+          // Margen para el error de redondeo del centro y el radio
+          double r = sqrt(distSq(ox, oz, a.x, a.z));
+          r += EPSILON * (1.0 + fabs(ox) + fabs(oz) + r);
+          done = !pendingIn(j, ox - r, oz - r, ox + r, oz + r);
+        }
+      }
+      if (!done) {
+        for (unsigned int k = 0; k < 3; k++) keepPoint[T[3 * t + k]] = 1;
+        continue;
+      }
+      for (unsigned int k = 0; k < 3; k++) tri[k] = ids[T[3 * t + k]];
+      out.write(reinterpret_cast<const char*>(tri.data()), 3 * sizeof(unsigned int));
+      triangleCount++;
+      for (unsigned int k = 0; k < 3; k++) {
+        unsigned int u = tri[k], v = tri[(k + 1) % 3];
+        if (!written.erase(edgeKey(v, u))) written[edgeKey(u, v)] = 1;
+      }
+    }
+    if (last) break;
+
+    // El frente: vértices de triángulos sin escribir y de aristas escritas en el borde
+    unordered_map<unsigned int, unsigned int> local;
+    for (unsigned int i = 0; i < ids.size(); i++) local[ids[i]] = i;
+    for (auto& [key, unused] : written) {
+      keepPoint[local[key >> 32]] = 1;
+      keepPoint[local[key & 0xffffffffu]] = 1;
+    }
+    unsigned int next = 0;
+    for (unsigned int i = 0; i < pts.size(); i++) {
+      if (keepPoint[i]) active[next++] = active[i];
+    }
+    active.resize(next);
+  }
+}
+
+unsigned int StreamingDelaunay::cellCol(double x, double z) const {
+  double c = (alongX ? z - minZ : x - minX) / cellSize;
+  return c <= 0 ? 0 : min(cols - 1, static_cast<unsigned int>(c));
+}
+
+unsigned int StreamingDelaunay::cellRow(double x, double z) const {
+  double c = (alongX ? x - minX : z - minZ) / cellSize;
+  return c <= 0 ? 0 : min(rows - 1, static_cast<unsigned int>(c));
+}
+
+// ¿Hay puntos de filas después de `row` en la caja [x0, x1] x [z0, z1]?
+bool StreamingDelaunay::pendingIn(unsigned int row, double x0, double z0, double x1, double z1) const {
+  if (x1 < minX || x0 > maxX || z1 < minZ || z0 > maxZ) return false;
+  unsigned int i0 = cellCol(x0, z0), i1 = cellCol(x1, z1);
+  for (unsigned int j = max(row + 1, cellRow(x0, z0)); j <= cellRow(x1, z1); j++) {
+    const unsigned int* pre = rowPrefix.data() + static_cast<size_t>(j) * (cols + 1);
+    if (pre[i1 + 1] > pre[i0]) return true;
+  }
+  return false;
+}
+
+// Llama a f con cada punto válido del archivo, en orden
+void StreamingDelaunay::readPoints(const string& input, const function<void(const Point3&)>& f) const {
+  ifstream file(input);
+  if (!file.is_open()) throw runtime_error("StreamingDelaunay: no se encontró " + input);
+  string line;
+  while (getline(file, line)) {
+    stringstream ss(line);
+    double x, y, z;
+    if (!(ss >> x >> y >> z)) continue;
+    f(Point3(x, y, z));
+  }
+}
+
+#endif
@@ -0,0 +1,274 @@
+#ifndef TIN_H
+#define TIN_H
+
+#include "point_location.hpp"
+#include <atomic>
+
+using namespace std;
+
+enum TinMode { LINEAR, NATURAL };
+
+// Interpolación de alturas sobre la triangulación tomada como terreno (TIN): los puntos están
+// en el plano XZ y la altura es Point3::y. LINEAR usa las coordenadas baricéntricas del
+// triángulo que contiene al punto; NATURAL usa vecinos naturales (Sibson): el peso de cada
+// vecino es el área que el punto le quitaría a su celda de Voronoi. Fuera de la envolvente el
+// resultado es NaN.
+class TinInterpolator {
+public:
+  const Delaunay& delaunay;
+  PointLocator locator;
+
+  TinInterpolator(const Delaunay& d) : delaunay(d), locator(d) {}
+
+  double linear(double x, double z) const;
+  double natural(double x, double z) const;
+  // Muchas consultas: se localizan en lote y se interpolan en paralelo (threads = 0: todos los núcleos)
+  vector<double> interpolate(const vector<Point3>& queries, TinMode mode = LINEAR, unsigned int threads = 0) const;
+  // Rejilla de alturas (cols x rows, fila por fila) con la interpolación lineal en el centro
+  // de cada celda. Se reparte en bloques de TIN_TILE x TIN_TILE celdas; cada bloque recorre
+  // los triángulos que lo tocan y llena las celdas que cubren.
+  vector<float> rasterize(double minX, double minZ, double cellSize, unsigned int cols, unsigned int rows,
+                          unsigned int threads = 0) const;
+
+private:
+  // Memoria que natural reutiliza entre consultas
+  struct Scratch {
+    vector<unsigned int> cavity, stack, boundary;
+  };
+
+  double linearIn(unsigned int t, double x, double z) const;
+  double naturalIn(unsigned int t, double x, double z, Scratch& s) const;
+};
+
+#define TIN_TILE 256
+
+// Centro del círculo que pasa por a, b y c; falso si son colineales
+inline bool circumcenter(double ax, double ay, double bx, double by, double cx, double cy, double& x, double& y) {
+  double dx = bx - ax, dy = by - ay;
+  double ex = cx - ax, ey = cy - ay;
+  double bl = dx * dx + dy * dy;
+  double cl = ex * ex + ey * ey;
+  double d = dx * ey - dy * ex;
+  if (d == 0.0) return false;
+  x = ax + (ey * bl - dy * cl) * 0.5 / d;
+  y = ay + (dx * cl - ex * bl) * 0.5 / d;
+  return true;
+}
+
+double TinInterpolator::linear(double x, double z) const {
+  unsigned int t = locator.locate(x, z);
+  return t == INVALID ? numeric_limits<double>::quiet_NaN() : linearIn(t, x, z);
+}
+
+double TinInterpolator::natural(double x, double z) const {
+  unsigned int t = locator.locate(x, z);
+  Scratch s;
+  return t == INVALID ? numeric_limits<double>::quiet_NaN() : naturalIn(t, x, z, s);
+}
+
+double TinInterpolator::linearIn(unsigned int t, double x, double z) const {
+  const Point3& a = delaunay.points[delaunay.triangles[3 * t]];
+  const Point3& b = delaunay.points[delaunay.triangles[3 * t + 1]];
+  const Point3& c = delaunay.points[delaunay.triangles[3 * t + 2]];
+  double d = (b.x - a.x) * (c.z - a.z) - (b.z - a.z) * (c.x - a.x);
+  if (d == 0.0) {
+    // Triángulo plano en la envolvente: interpolar sobre su lado más largo
+    const Point3* p = &a;
+    const Point3* q = &b;
+    if (distSq(a.x, a.z, c.x, c.z) > distSq(p->x, p->z, q->x, q->z)) q = &c;
+    if (distSq(b.x, b.z, c.x, c.z) > distSq(p->x, p->z, q->x, q->z)) p = &b, q = &c;
+    double l = distSq(p->x, p->z, q->x, q->z);
+    if (l == 0.0) return p->y;
+    double s = ((x - p->x) * (q->x - p->x) + (z - p->z) * (q->z - p->z)) / l;
+    s = min(1.0, max(0.0, s));
+    return p->y + s * (q->y - p->y);
+  }
+  double u = ((b.x - x) * (c.z - z) - (b.z - z) * (c.x - x)) / d;
+  double v = ((c.x - x) * (a.z - z) - (c.z - z) * (a.x - x)) / d;
+  return u * a.y + v * b.y + (1.0 - u - v) * c.y;
+}
+
+// Sibson con los triángulos cuyo círculo contiene al punto (la cavidad que abriría al
+// insertarlo). Para cada vecino v del borde de la cavidad, el área robada es el polígono que
+// forman el circuncentro de (q, anterior, v), los circuncentros de los triángulos de la
+// cavidad alrededor de v y el circuncentro de (q, v, siguiente).
+double TinInterpolator::naturalIn(unsigned int t0, double x, double z, Scratch& s) const {
+  const vector<unsigned int>& T = delaunay.triangles;
+  const vector<unsigned int>& H = delaunay.halfedges;
+  const vector<Point3>& P = delaunay.points;
+  for (unsigned int j = 0; j < 3; j++) {
+    const Point3& p = P[T[3 * t0 + j]];
+    if (p.x == x && p.z == z) return p.y;
+  }
+
+  auto inCavity = [&](unsigned int t) {
+    const Point3& a = P[T[3 * t]];
+    const Point3& b = P[T[3 * t + 1]];
+    const Point3& c = P[T[3 * t + 2]];
+    return InCircle(a.x, a.z, b.x, b.z, c.x, c.z, x, z);
+  };
+  auto contains = [&](unsigned int t) { return find(s.cavity.begin(), s.cavity.end(), t) != s.cavity.end(); };
+
+  s.cavity.assign(1, t0);
+  s.stack.assign(1, t0);
+  s.boundary.clear();
+  while (!s.stack.empty()) {
+    unsigned int t = s.stack.back();
+    s.stack.pop_back();
+    for (unsigned int e = 3 * t; e < 3 * t + 3; e++) {
+      unsigned int tw = H[e];
+      if (tw != INVALID && contains(tw / 3)) continue;
+      if (tw != INVALID && inCavity(tw / 3)) {
+        s.cavity.push_back(tw / 3);
+        s.stack.push_back(tw / 3);
+      } else {
+        s.boundary.push_back(e);
+      }
+    }
+  }
+  // Un triángulo que entró después que su vecino pudo dejar la arista entre los dos en el borde
+  s.boundary.erase(remove_if(s.boundary.begin(), s.boundary.end(), [&](unsigned int e) {
+    return H[e] != INVALID && contains(H[e] / 3);
+  }), s.boundary.end());
+
+  double total = 0.0, sum = 0.0;
+  for (unsigned int e : s.boundary) {
+    // Arista u -> v del borde; se suma el área robada a v entre esta arista y la siguiente
+    unsigned int u = T[e], v = T[nextHalfedge(e)];
+    double gx, gz, hx, hz;
+    // Colineal con q solo pasa en una arista de la envolvente, donde las celdas no son
+    // acotadas: ahí vecinos naturales coincide con la interpolación lineal sobre la arista
+    if (!circumcenter(x, z, P[u].x, P[u].z, P[v].x, P[v].z, gx, gz)) return linearIn(t0, x, z);
+
+    // Girar alrededor de v dentro de la cavidad hasta la arista del borde que sale de v
+    double area = 0.0, px = gx, pz = gz;
+    unsigned int h = e;
+    unsigned int w = INVALID;
+    for (unsigned int k = 0; k <= s.cavity.size(); k++) {
+      unsigned int t = h / 3;
+      double cx, cz;
+      const Point3& a = P[T[3 * t]];
+      const Point3& b = P[T[3 * t + 1]];
+      const Point3& c = P[T[3 * t + 2]];
+      if (circumcenter(a.x, a.z, b.x, b.z, c.x, c.z, cx, cz)) {
+        area += px * cz - cx * pz;
+        px = cx;
+        pz = cz;
+      }
+      unsigned int out = nextHalfedge(h);
+      if (H[out] == INVALID || !contains(H[out] / 3)) {
+        w = T[nextHalfedge(out)];
+        break;
+      }
+      h = H[out];
+    }
+    if (w == INVALID || !circumcenter(x, z, P[v].x, P[v].z, P[w].x, P[w].z, hx, hz)) return linearIn(t0, x, z);
+    area += px * hz - hx * pz;
+    area += hx * gz - gx * hz;
+    area = fabs(area) * 0.5;
+    total += area;
+    sum += area * P[v].y;
+  }
+  return total > 0.0 ? sum / total : linearIn(t0, x, z);
+}
+
+vector<double> TinInterpolator::interpolate(const vector<Point3>& queries, TinMode mode, unsigned int threads) const {
+  unsigned int n = queries.size();
+  vector<unsigned int> tri = locator.locate(queries, threads);
+  vector<double> result(n);
+  if (threads == 0) threads = max(1u, thread::hardware_concurrency());
+  threads = max(1u, min(threads, n / POINT_LOCATION_MIN_PER_THREAD));
+  forChunks(n, threads, [&](unsigned int lo, unsigned int hi, unsigned int) {
+    Scratch s;
+    for (unsigned int k = lo; k < hi; k++) {
+      const Point3& q = queries[k];
+      if (tri[k] == INVALID) result[k] = numeric_limits<double>::quiet_NaN();
+      else result[k] = mode == LINEAR ? linearIn(tri[k], q.x, q.z) : naturalIn(tri[k], q.x, q.z, s);
+    }
+  });
+  return result;
+}
+
+vector<float> TinInterpolator::rasterize(double minX, double minZ, double cellSize, unsigned int cols, unsigned int rows,
+                                         unsigned int threads) const {
+  if (cellSize <= 0.0) throw runtime_error("rasterize: tamaño de celda inválido");
+  const vector<unsigned int>& T = delaunay.triangles;
+  const vector<Point3>& P = delaunay.points;
+  vector<float> grid(static_cast<size_t>(cols) * rows, numeric_limits<float>::quiet_NaN());
+  unsigned int tilesX = (cols + TIN_TILE - 1) / TIN_TILE, tilesZ = (rows + TIN_TILE - 1) / TIN_TILE;
+  unsigned int tiles = tilesX * tilesZ;
+  if (tiles == 0) return grid;
+
+  // Celdas cuyo centro cae en la caja del triángulo: [i0, i1] x [j0, j1]; falso si ninguna
+  auto cellRange = [&](unsigned int t, int& i0, int& i1, int& j0, int& j1) {
+    const Point3& a = P[T[3 * t]];
+    const Point3& b = P[T[3 * t + 1]];
+    const Point3& c = P[T[3 * t + 2]];
+    double x0 = min(a.x, min(b.x, c.x)), x1 = max(a.x, max(b.x, c.x));
+    double z0 = min(a.z, min(b.z, c.z)), z1 = max(a.z, max(b.z, c.z));
+    i0 = min<double>(cols, max(0.0, ceil((x0 - minX) / cellSize - 0.5)));
+    j0 = min<double>(rows, max(0.0, ceil((z0 - minZ) / cellSize - 0.5)));
+    i1 = max(-1.0, min(cols - 1.0, floor((x1 - minX) / cellSize - 0.5)));
+    j1 = max(-1.0, min(rows - 1.0, floor((z1 - minZ) / cellSize - 0.5)));
+    return i0 <= i1 && j0 <= j1;
+  };
+
+  // Triángulos de cada bloque en formato CSR: se cuentan, se acumulan y se reparten
+  unsigned int m = T.size() / 3;
+  vector<unsigned int> start(tiles + 1, 0), list;
+  for (int pass = 0; pass < 2; pass++) {
+    vector<unsigned int> at(start.begin(), start.end() - 1);
+    for (unsigned int t = 0; t < m; t++) {
+      int i0, i1, j0, j1;
+      if (T[3 * t] == INVALID || !cellRange(t, i0, i1, j0, j1)) continue;
+      for (int tz = j0 / TIN_TILE; tz <= j1 / TIN_TILE; tz++) {
+        for (int tx = i0 / TIN_TILE; tx <= i1 / TIN_TILE; tx++) {
+          if (pass) list[at[tz * tilesX + tx]++] = t;
+          else start[tz * tilesX + tx + 1]++;
+        }
+      }
+    }
+    if (pass == 0) {
+      for (unsigned int k = 0; k < tiles; k++) start[k + 1] += start[k];
+      list.resize(start[tiles]);
+    }
+  }
+
+  if (threads == 0) threads = max(1u, thread::hardware_concurrency());
+  threads = max(1u, min(threads, tiles));
+  atomic<unsigned int> next(0);
+  forChunks(threads, threads, [&](unsigned int, unsigned int, unsigned int) {
+    for (unsigned int k = next++; k < tiles; k = next++) {
+      int tx = k % tilesX, tz = k / tilesX;
+      for (unsigned int s = start[k]; s < start[k + 1]; s++) {
+        unsigned int t = list[s];
+        int i0, i1, j0, j1;
+        cellRange(t, i0, i1, j0, j1);
+        i0 = max(i0, tx * TIN_TILE);
+        j0 = max(j0, tz * TIN_TILE);
+        i1 = min(i1, tx * TIN_TILE + TIN_TILE - 1);
+        j1 = min(j1, tz * TIN_TILE + TIN_TILE - 1);
+        const Point3& a = P[T[3 * t]];
+        const Point3& b = P[T[3 * t + 1]];
+        const Point3& c = P[T[3 * t + 2]];
+        double d = (b.x - a.x) * (c.z - a.z) - (b.z - a.z) * (c.x - a.x);
+        if (d == 0.0) continue;
+        for (int j = j0; j <= j1; j++) {
+          double z = minZ + (j + 0.5) * cellSize;
+          for (int i = i0; i <= i1; i++) {
+            double x = minX + (i + 0.5) * cellSize;
+            double u = ((b.x - x) * (c.z - z) - (b.z - z) * (c.x - x)) / d;
+            double v = ((c.x - x) * (a.z - z) - (c.z - z) * (a.x - x)) / d;
+            double w = 1.0 - u - v;
+            // Tolerancia para las celdas justo sobre una arista de la envolvente
+            if (u < -EPSILON || v < -EPSILON || w < -EPSILON) continue;
+            grid[static_cast<size_t>(j) * cols + i] = u * a.y + v * b.y + w * c.y;
+          }
+        }
+      }
+    }
+  });
+  return grid;
+}
+
+#endif
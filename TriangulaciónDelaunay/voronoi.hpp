@@ -0,0 +1,224 @@
+#ifndef VORONOI_H
+#define VORONOI_H
+
+#include "delaunay.hpp"
+
+using namespace std;
+
+// Diagrama de Voronoi leído directamente de una triangulación, sin copiarla: la celda del
+// vértice v tiene como vértices los circuncentros de los triángulos alrededor de v, en el
+// orden en que se recorren con halfedges. Las celdas se recortan a una caja y se guardan en
+// formato CSR: la celda v son los puntos cellStart[v] .. cellStart[v + 1] - 1 de cellX/cellZ,
+// en sentido antihorario en (x, z). Los puntos que no están en la triangulación (repetidos o
+// quitados) y las celdas que quedan fuera de la caja están vacías.
+class Voronoi {
+public:
+  const Delaunay& delaunay;
+  vector<double> centerX, centerZ;   // Circuncentro de cada triángulo, NaN si es plano o está borrado
+  vector<unsigned int> cellStart;
+  vector<double> cellX, cellZ;
+
+  struct Cell {
+    unsigned int site;
+    const double* x;
+    const double* z;
+    unsigned int size;
+  };
+
+  class iterator {
+    const Voronoi* v;
+    unsigned int i;
+  public:
+    iterator(const Voronoi* v, unsigned int i) : v(v), i(i) {}
+    Cell operator*() const { return v->cell(i); }
+    iterator& operator++() { i++; return *this; }
+    bool operator!=(const iterator& o) const { return i != o.i; }
+  };
+
+  // threads = 0 usa todos los núcleos
+  Voronoi(const Delaunay& d, double minX, double minZ, double maxX, double maxZ, unsigned int threads = 0);
+
+  unsigned int size() const { return cellStart.size() - 1; }
+  Cell cell(unsigned int v) const {
+    return {v, cellX.data() + cellStart[v], cellZ.data() + cellStart[v], cellStart[v + 1] - cellStart[v]};
+  }
+  iterator begin() const { return iterator(this, 0); }
+  iterator end() const { return iterator(this, size()); }
+
+private:
+  double minX, minZ, maxX, maxZ;
+  vector<unsigned int> inedges;      // Un halfedge que llega a cada vértice
+
+  // Lo que escribe cada hilo antes de juntar todo; se reutiliza entre celdas
+  struct Chunk {
+    vector<unsigned int> sites;      // Vértices en el orden en que se hicieron sus celdas
+    vector<double> x, z;
+    vector<unsigned int> neighbors;
+    vector<double> clipX, clipZ, tmpX, tmpZ;
+  };
+
+  void computeCenters(unsigned int threads);
+  void buildCells(unsigned int lo, unsigned int hi, Chunk& c, vector<unsigned int>& size);
+  void clipCell(unsigned int v, Chunk& c);
+};
+
+// Con menos triángulos por hilo no vale la pena partir
+#define VORONOI_MIN_PER_THREAD (1u << 15)
+
+Voronoi::Voronoi(const Delaunay& d, double minX, double minZ, double maxX, double maxZ, unsigned int threads)
+  : delaunay(d), minX(minX), minZ(minZ), maxX(maxX), maxZ(maxZ) {
+  if (minX > maxX || minZ > maxZ) throw runtime_error("Voronoi: caja vacía");
+  const vector<unsigned int>& T = d.triangles;
+  const vector<unsigned int>& H = d.halfedges;
+  unsigned int n = d.points.size();
+  if (threads == 0) threads = max(1u, thread::hardware_concurrency());
+  threads = max(1u, min(threads, static_cast<unsigned int>(T.size() / 3) / VORONOI_MIN_PER_THREAD));
+
+  computeCenters(threads);
+
+  // En la envolvente se prefiere el halfedge de la envolvente, así la vuelta alrededor del
+  // vértice empieza en un extremo
+  inedges.assign(n, INVALID);
+  for (unsigned int e = 0; e < T.size(); e++) {
+    if (T[e] == INVALID) continue;
+    unsigned int v = T[nextHalfedge(e)];
+    if (H[e] == INVALID || inedges[v] == INVALID) inedges[v] = e;
+  }
+
+  // Las celdas se hacen en el orden de los halfedges y no en el de los vértices: triángulos
+  // vecinos suelen estar cerca en memoria, los vértices no
+  vector<Chunk> chunks(threads);
+  cellStart.assign(n + 1, 0);
+  forChunks(T.size() / 3, threads, [&](unsigned int lo, unsigned int hi, unsigned int k) {
+    buildCells(3 * lo, 3 * hi, chunks[k], cellStart);
+  });
+
+  // cellStart tenía el tamaño de cada celda; cada hilo copia sus celdas a su lugar
+  unsigned int sum = 0;
+  for (unsigned int v = 0; v <= n; v++) {
+    unsigned int s = cellStart[v];
+    cellStart[v] = sum;
+    sum += s;
+  }
+  cellX.resize(sum);
+  cellZ.resize(sum);
+  forChunks(threads, threads, [&](unsigned int k, unsigned int, unsigned int) {
+    Chunk& c = chunks[k];
+    unsigned int from = 0;
+    for (unsigned int v : c.sites) {
+      unsigned int m = cellStart[v + 1] - cellStart[v];
+      copy(c.x.begin() + from, c.x.begin() + from + m, cellX.begin() + cellStart[v]);
+      copy(c.z.begin() + from, c.z.begin() + from + m, cellZ.begin() + cellStart[v]);
+      from += m;
+    }
+  });
+}
+
+// Un circuncentro por triángulo, repartidos entre hilos
+void Voronoi::computeCenters(unsigned int threads) {
+  const vector<unsigned int>& T = delaunay.triangles;
+  const vector<Point3>& P = delaunay.points;
+  unsigned int m = T.size() / 3;
+  centerX.resize(m);
+  centerZ.resize(m);
+  const double nan = numeric_limits<double>::quiet_NaN();
+  forChunks(m, threads, [&](unsigned int lo, unsigned int hi, unsigned int) {
+    for (unsigned int t = lo; t < hi; t++) {
+      if (T[3 * t] == INVALID) {
+        centerX[t] = centerZ[t] = nan;
+        continue;
+      }
+      const Point3& a = P[T[3 * t]];
+      const Point3& b = P[T[3 * t + 1]];
+      const Point3& c = P[T[3 * t + 2]];
+      double dx = b.x - a.x, dy = b.z - a.z;
+      double ex = c.x - a.x, ey = c.z - a.z;
+      double bl = dx * dx + dy * dy;
+      double cl = ex * ex + ey * ey;
+      double d = dx * ey - dy * ex;
+      // Triángulo plano: el centro está en el infinito
+      double s = fabs(d) < EPSILON ? nan : 0.5 / d;
+      centerX[t] = a.x + (ey * bl - dy * cl) * s;
+      centerZ[t] = a.z + (dx * cl - ex * bl) * s;
+    }
+  });
+}
+
+// Celdas de los vértices cuyo halfedge de inedges está en lo .. hi - 1; el tamaño de cada una
+// va a size[v]. Si la vuelta alrededor del vértice se cierra y todos los circuncentros caen en
+// la caja la celda son los circuncentros; si no (envolvente o celda que sale de la caja) se
+// recorta la caja con las mediatrices de los vecinos.
+void Voronoi::buildCells(unsigned int lo, unsigned int hi, Chunk& c, vector<unsigned int>& size) {
+  const vector<unsigned int>& T = delaunay.triangles;
+  const vector<unsigned int>& H = delaunay.halfedges;
+  c.x.reserve(hi - lo);
+  c.z.reserve(hi - lo);
+  for (unsigned int e0 = lo; e0 < hi; e0++) {
+    if (T[e0] == INVALID) continue;
+    unsigned int v = T[nextHalfedge(e0)];
+    if (inedges[v] != e0) continue;
+    unsigned int first = c.x.size();
+    bool bounded = true;
+    c.neighbors.clear();
+    unsigned int e = e0;
+    do {
+      unsigned int t = e / 3;
+      double x = centerX[t], z = centerZ[t];
+      // Con NaN las comparaciones son falsas, así que un centro en el infinito no está en la caja
+      if (!(x >= minX && x <= maxX && z >= minZ && z <= maxZ)) bounded = false;
+      c.x.push_back(x);
+      c.z.push_back(z);
+      c.neighbors.push_back(T[e]);
+      unsigned int n = nextHalfedge(e);
+      e = H[n];
+      if (e == INVALID) {
+        c.neighbors.push_back(T[nextHalfedge(n)]);
+        bounded = false;
+      }
+    } while (e != INVALID && e != e0);
+
+    if (!bounded) {
+      c.x.resize(first);
+      c.z.resize(first);
+      clipCell(v, c);
+    }
+    c.sites.push_back(v);
+    size[v] = c.x.size() - first;
+  }
+}
+
+// Recorta la caja con el semiplano más cercano a v que a cada vecino (Sutherland-Hodgman)
+void Voronoi::clipCell(unsigned int v, Chunk& c) {
+  const vector<Point3>& P = delaunay.points;
+  c.clipX.assign({minX, maxX, maxX, minX});
+  c.clipZ.assign({minZ, minZ, maxZ, maxZ});
+  double vx = P[v].x, vz = P[v].z;
+  for (unsigned int u : c.neighbors) {
+    double nx = P[u].x - vx, nz = P[u].z - vz;
+    double mx = 0.5 * (P[u].x + vx), mz = 0.5 * (P[u].z + vz);
+    unsigned int m = c.clipX.size();
+    c.tmpX.clear();
+    c.tmpZ.clear();
+    for (unsigned int k = 0; k < m; k++) {
+      unsigned int j = k + 1 == m ? 0 : k + 1;
+      double fk = nx * (c.clipX[k] - mx) + nz * (c.clipZ[k] - mz);
+      double fj = nx * (c.clipX[j] - mx) + nz * (c.clipZ[j] - mz);
+      if (fk <= 0) {
+        c.tmpX.push_back(c.clipX[k]);
+        c.tmpZ.push_back(c.clipZ[k]);
+      }
+      if ((fk <= 0) != (fj <= 0)) {
+        double s = fk / (fk - fj);
+        c.tmpX.push_back(c.clipX[k] + s * (c.clipX[j] - c.clipX[k]));
+        c.tmpZ.push_back(c.clipZ[k] + s * (c.clipZ[j] - c.clipZ[k]));
+      }
+    }
+    c.clipX.swap(c.tmpX);
+    c.clipZ.swap(c.tmpZ);
+    if (c.clipX.empty()) return;
+  }
+  c.x.insert(c.x.end(), c.clipX.begin(), c.clipX.end());
+  c.z.insert(c.z.end(), c.clipZ.begin(), c.clipZ.end());
+}
+
+#endif
@@ -48,7 +48,7 @@ struct Point{
   return *this;
  }
 
- bool operator==(Point o){
+ bool operator==(Point o) const{
   return (fabs(x-o.x) < EPS && fabs(y-o.y) < EPS);
  }
 };
@@ -79,8 +79,9 @@ Point operator/(Point p, double esc){
  return p*esc;
 }
 
+// Orden lexicografico exacto; con EPS no seria un orden estricto debil y sort puede fallar
 bool operator<(Point p, Point q){
- return (p.x < q.x || (fabs((p.x - q.x)) < EPS && p.y < q.y));
+ return (p.x < q.x || (p.x == q.x && p.y < q.y));
 }
 
 double cross(Point p, Point q){
@@ -105,6 +106,11 @@ int orientation(Point p, Point q, Point r){
  return (val < 0 ? LEFT : RIGHT);
 }
 
+// Vuelta estrictamente a la izquierda (antihorario) de p->q->r
+bool ccw(Point p, Point q, Point r){
+ return cross(q-p,r-p) > EPS;
+}
+
 bool inBounds(Point p, Point q, Point r){
  return (r.x <= max(p.x, q.x) && r.x >= min(p.x, q.x) && r.y <= max(p.y, q.y) && r.y >= min(p.y, q.y));
 }
@@ -0,0 +1,112 @@
+/*Renderer 2D por capas para las animaciones: un VBO dinamico por capa y una llamada por capa*/
+#ifndef RENDERER2D_H
+#define RENDERER2D_H
+#include <GL/glew.h>
+#include <vector>
+#include <algorithm>
+#include "geo.hpp"
+
+using namespace std;
+
+// Cada capa guarda sus vertices (x, y, r, g, b, a) en CPU y en un VBO. Al dibujar solo se
+// sube lo que cambio desde el ultimo cuadro (normalmente lo que se agrego al final) y se
+// dibuja todo con un solo glDrawArrays. Usa los arreglos de cliente de OpenGL 1.5
+// (glVertexPointer/glColorPointer) para funcionar con el contexto de compatibilidad que
+// crea GLFW y con Mesa llvmpipe en maquinas sin GPU.
+class Layer2D{
+    private:
+    static const int FLOATS = 6;
+    GLenum mode;
+    float size;
+    vector<float> data;
+    unsigned int VBO = 0;
+    int capacity = 0;       // Vertices que caben en el VBO
+    int dirtyFrom = 0;      // Primer vertice que no esta en el VBO
+
+    void markDirty(int i){ dirtyFrom = min(dirtyFrom, i); }
+
+    public:
+    // mode es GL_POINTS, GL_LINES, GL_LINE_STRIP o GL_TRIANGLES; size es el tamaño del punto o el grosor de linea
+    Layer2D(GLenum mode = GL_POINTS, float size = 1.0f) : mode(mode), size(size) {}
+    Layer2D(const Layer2D&) = delete;
+    Layer2D& operator=(const Layer2D&) = delete;
+
+    int count() const { return (int)data.size() / FLOATS; }
+
+    void add(Point p, float r, float g, float b, float a = 1.0f){
+        data.insert(data.end(), {(float)p.x, (float)p.y, r, g, b, a});
+    }
+
+    void addLine(Point p, Point q, float r, float g, float b, float a = 1.0f){
+        add(p, r, g, b, a);
+        add(q, r, g, b, a);
+    }
+
+    // Abanico convertido a triangulos sueltos, asi varios abanicos caben en una capa GL_TRIANGLES
+    void addFan(Point center, const vector<Point> &poly, float r, float g, float b, float a = 1.0f){
+        for(int i = 0; i + 1 < sz(poly); i++){
+            add(center, r, g, b, a);
+            add(poly[i], r, g, b, a);
+            add(poly[i+1], r, g, b, a);
+        }
+    }
+
+    // Cambia el color del vertice i
+    void setColor(int i, float r, float g, float b, float a = 1.0f){
+        float *v = &data[(size_t)i * FLOATS];
+        v[2] = r; v[3] = g; v[4] = b; v[5] = a;
+        markDirty(i);
+    }
+
+    // Se queda con los primeros n vertices (por ejemplo al sacar de una pila)
+    void truncate(int n){
+        if(n >= count()) return;
+        data.resize((size_t)n * FLOATS);
+        markDirty(n);
+    }
+
+    void clear(){ truncate(0); }
+
+    void draw(){
+        int n = count();
+        if(n == 0) return;
+        if(!VBO) glGenBuffers(1, &VBO);
+        glBindBuffer(GL_ARRAY_BUFFER, VBO);
+
+        if(n > capacity){
+            // Crece al doble para que agregar sea O(1) amortizado
+            capacity = max(n, 2 * capacity);
+            glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)capacity * FLOATS * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
+            dirtyFrom = 0;
+        }
+        if(dirtyFrom < n){
+            glBufferSubData(GL_ARRAY_BUFFER, (GLintptr)dirtyFrom * FLOATS * sizeof(float),
+                            (GLsizeiptr)(n - dirtyFrom) * FLOATS * sizeof(float), &data[(size_t)dirtyFrom * FLOATS]);
+        }
+        dirtyFrom = n;
+
+        GLsizei stride = FLOATS * sizeof(float);
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glEnableClientState(GL_COLOR_ARRAY);
+        glVertexPointer(2, GL_FLOAT, stride, (void*)0);
+        glColorPointer(4, GL_FLOAT, stride, (void*)(2 * sizeof(float)));
+        if(mode == GL_POINTS) glPointSize(size);
+        else glLineWidth(size);
+
+        glDrawArrays(mode, 0, n);
+
+        glDisableClientState(GL_COLOR_ARRAY);
+        glDisableClientState(GL_VERTEX_ARRAY);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    // Libera el VBO; se llama antes de glfwTerminate porque las capas suelen ser globales y
+    // su destructor corre cuando ya no hay contexto
+    void release(){
+        if(VBO) glDeleteBuffers(1, &VBO);
+        VBO = 0;
+        capacity = 0;
+        dirtyFrom = 0;
+    }
+};
+#endif
@@ -0,0 +1,158 @@
+/*Planificador de pasos para las animaciones: separa los pasos del algoritmo de los cuadros*/
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <thread>
+#include <algorithm>
+
+using namespace std;
+
+// Corre tantos pasos como tocan segun la velocidad (pasos por segundo) sin pasarse del
+// presupuesto de tiempo por cuadro. Con velocidad infinita solo limita el presupuesto.
+// La velocidad, la pausa y "terminar" son atomicos para poder cambiarlos desde el hilo de
+// la ventana mientras los pasos corren en un StepWorker.
+class StepScheduler{
+    private:
+    using Clock = chrono::steady_clock;
+    atomic<double> sps;
+    atomic<bool> paused{false}, finishing{false}, finished{false};
+    double budget;
+    double credit = 0;
+    Clock::time_point last = Clock::now();
+    long long total = 0;
+    double busy = 0;
+
+    public:
+    // budget en segundos; ~10 ms deja tiempo para dibujar a 60 cuadros por segundo
+    StepScheduler(double stepsPerSecond = 20, double budget = 0.010) : sps(stepsPerSecond), budget(budget) {}
+
+    // step() hace un paso y regresa falso cuando ya no hay mas. Regresa cuantos pasos hizo.
+    template<class Step>
+    long long advance(Step step){
+        Clock::time_point now = Clock::now();
+        double dt = chrono::duration<double>(now - last).count();
+        last = now;
+        if(finished || paused) return 0;
+
+        bool all = finishing;
+        double rate = sps;
+        // A lo mas un cuarto de segundo de atraso, para no dar un salto despues de una pausa larga
+        credit = min(credit + rate * dt, max(1.0, rate * 0.25));
+        long long limit = all ? LLONG_MAX : (long long)credit;
+
+        long long k = 0;
+        while(k < limit){
+            if(!step()){
+                finished = true;
+                break;
+            }
+            k++;
+            // El reloj se consulta cada 64 pasos; "terminar" ignora el presupuesto
+            if(!all && (k & 63) == 0 && chrono::duration<double>(Clock::now() - now).count() > budget) break;
+        }
+        credit = finished ? 0 : max(0.0, credit - k);
+        total += k;
+        busy += chrono::duration<double>(Clock::now() - now).count();
+        return k;
+    }
+
+    void faster(){ sps = sps * 2; }
+    void slower(){ sps = max(0.25, sps / 2); }
+    void finish(){ finishing = true; }
+    void togglePause(){ paused = !paused; }
+
+    // Para cuando aparecen pasos nuevos despues de terminar (por ejemplo en la galeria)
+    void restart(){
+        finished = false;
+        finishing = false;
+        credit = 0;
+        last = Clock::now();
+    }
+
+    // Flechas arriba/abajo: velocidad x2 o /2, F: terminar, espacio: pausa
+    bool handleKey(int key){
+        switch(key){
+            case GLFW_KEY_UP: faster(); return true;
+            case GLFW_KEY_DOWN: slower(); return true;
+            case GLFW_KEY_F: finish(); return true;
+            case GLFW_KEY_SPACE: togglePause(); return true;
+        }
+        return false;
+    }
+
+    bool done() const { return finished; }
+    double stepsPerSecond() const { return sps; }
+    long long steps() const { return total; }
+    // Segundos dentro de los pasos, sin contar pausas ni la espera entre cuadros
+    double busySeconds() const { return busy; }
+};
+
+// Triple buffer sin candados para pasar el estado a dibujar de un hilo a otro: el escritor
+// llena back() y lo publica, el lector toma el ultimo publicado. Ninguno espera al otro y
+// el lector nunca ve un estado a medio escribir.
+template<class T>
+class TripleBuffer{
+    private:
+    static const int FRESH = 4, INDEX = 3;
+    T slot[3];
+    int backIdx = 0, frontIdx = 1;
+    atomic<int> middle{2};
+
+    public:
+    T& back(){ return slot[backIdx]; }
+
+    void publish(){
+        backIdx = middle.exchange(backIdx | FRESH, memory_order_acq_rel) & INDEX;
+    }
+
+    // El ultimo estado publicado, o nullptr si no hay uno nuevo desde la ultima lectura
+    const T* read(){
+        if(!(middle.load(memory_order_acquire) & FRESH)) return nullptr;
+        frontIdx = middle.exchange(frontIdx, memory_order_acq_rel) & INDEX;
+        return &slot[frontIdx];
+    }
+};
+
+// Corre los pasos de un StepScheduler en otro hilo. Despues de cada tanda llama
+// snapshot(State&) para copiar lo que se va a dibujar y lo publica en un TripleBuffer,
+// asi la ventana dibuja a su ritmo aunque el algoritmo vaya mucho mas rapido.
+template<class State>
+class StepWorker{
+    private:
+    TripleBuffer<State> buffer;
+    atomic<bool> stopping{false};
+    thread worker;
+
+    public:
+    StepWorker() {}
+    StepWorker(const StepWorker&) = delete;
+    StepWorker& operator=(const StepWorker&) = delete;
+    ~StepWorker(){ stop(); }
+
+    template<class Step, class Snapshot>
+    void start(StepScheduler &sched, Step step, Snapshot snapshot){
+        worker = thread([this, &sched, step, snapshot]() mutable {
+            while(!stopping){
+                long long k = sched.advance(step);
+                if(k > 0 || sched.done()){
+                    snapshot(buffer.back());
+                    buffer.publish();
+                }
+                if(sched.done()) break;
+                this_thread::sleep_for(chrono::milliseconds(1));
+            }
+        });
+    }
+
+    const State* latest(){ return buffer.read(); }
+
+    void stop(){
+        stopping = true;
+        if(worker.joinable()) worker.join();
+    }
+};
+#endif